@@ -0,0 +1,101 @@
+//
+//  CatenisApiArena.h
+//  CatenisAPIClientCpp
+//
+#ifndef __CATENISAPIARENA_H__
+#define __CATENISAPIARENA_H__
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+namespace ctn
+{
+
+/*
+ * Memory arena that holds the results of API method calls
+ *
+ * Memory is handed out from large blocks, one piece after the other, and is only given back all at once, when the arena
+ *  is reset or destroyed. Resetting the arena keeps its blocks, so it can hold the results of successive calls without
+ *  allocating memory again. Results held in the arena must not be used once it is reset. An arena must not be used
+ *  from several threads at once
+ */
+class ResultArena
+{
+private:
+    struct Block
+    {
+        std::unique_ptr<char[]> data;
+        std::size_t size;
+    };
+
+    std::size_t block_size_;
+    std::vector<Block> blocks_;
+    // Block memory is currently taken from, and offset of its free space
+    std::size_t current_block_;
+    std::size_t offset_;
+
+public:
+    explicit ResultArena(std::size_t block_size = 64 * 1024);
+
+    ResultArena(const ResultArena &) = delete;
+    ResultArena &operator=(const ResultArena &) = delete;
+
+    void *allocate(std::size_t size, std::size_t alignment);
+
+    // Make all the memory of the arena available again
+    void reset();
+
+    // Total size of the blocks held by the arena
+    std::size_t capacity() const;
+};
+
+/*
+ * Allocator for standard containers and strings held in a result arena. Memory is only given back when the arena is
+ *  reset or destroyed
+ */
+template<typename T>
+class ArenaAllocator
+{
+private:
+    ResultArena *arena_;
+
+public:
+    typedef T value_type;
+
+    explicit ArenaAllocator(ResultArena &arena) : arena_(&arena) {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) : arena_(other.arena()) {}
+
+    T *allocate(std::size_t count)
+    {
+        return static_cast<T *>(arena_->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *, std::size_t) {}
+
+    ResultArena *arena() const { return arena_; }
+};
+
+template<typename T, typename U>
+inline bool operator==(const ArenaAllocator<T> &alloc1, const ArenaAllocator<U> &alloc2)
+{
+    return alloc1.arena() == alloc2.arena();
+}
+
+template<typename T, typename U>
+inline bool operator!=(const ArenaAllocator<T> &alloc1, const ArenaAllocator<U> &alloc2)
+{
+    return alloc1.arena() != alloc2.arena();
+}
+
+typedef std::basic_string<char, std::char_traits<char>, ArenaAllocator<char> > ArenaString;
+
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T> >;
+
+}
+
+#endif // __CATENISAPIARENA_H__
@@ -12,7 +12,13 @@
 #include <ctime>
 #include <list>
 #include <map>
+#include <vector>
 #include <memory>
+#include <functional>
+#include <future>
+#include <exception>
+
+#include <CatenisApiArena.h>
 
 // Version specific constants
 const std::string DEFAULT_API_VERSION = "0.5";
@@ -195,6 +201,255 @@ struct ListMessagesResult
     bool countExceeded;
 };
 
+/*
+ * Message description structure of a flat List Messages result. Optional values are held in place, along with a flag
+ *  indicating whether they have been returned
+ *
+ * @member messageId : ID of message.
+ * @member action : Action performed: 'log' or 'send'.
+ * @member direction : Direction of 'send' message: 'inbound' or 'outbound'.
+ * @member fromDevice : Index of the sending device in the device table of the result, or -1 if not returned.
+ * @member toDevice : Index of the target device in the device table of the result, or -1 if not returned.
+ * @member hasReadConfirmationEnabled : Indicates whether readConfirmationEnabled has been returned.
+ * @member readConfirmationEnabled : Indicates whether the message had been sent with read-confirmation enabled.
+ * @member hasRead : Indicates whether read has been returned.
+ * @member read : Indicates whether the message had already been read.
+ * @member date : ISO 8601 formatted date and time when message was logged, sent or received.
+ */
+struct FlatMessageDescription
+{
+    std::string messageId;
+    std::string action;
+    std::string direction;
+    int fromDevice;
+    int toDevice;
+    bool hasReadConfirmationEnabled;
+    bool readConfirmationEnabled;
+    bool hasRead;
+    bool read;
+    std::string date;
+
+    FlatMessageDescription() : fromDevice(-1), toDevice(-1), hasReadConfirmationEnabled(false), readConfirmationEnabled(false),
+        hasRead(false), read(false) {}
+};
+
+/*
+ * List Messages API method response structure, with the messages laid out contiguously
+ *
+ * @member messages : Descriptions of the messages.
+ * @member devices : Devices referred to by the messages, each one listed once.
+ * @member msgCount : Number of messages for which information is returned.
+ * @member countExceeded : Was the actual number of messages greater than the max returnable.
+ */
+struct FlatListMessagesResult
+{
+    std::vector<FlatMessageDescription> messages;
+    std::vector<DeviceInfo> devices;
+    int msgCount;
+    bool countExceeded;
+
+    // Device with the given index in the device table, or nullptr for index -1
+    const DeviceInfo *device(int index) const
+    {
+        return index >= 0 ? &devices[index] : nullptr;
+    }
+};
+
+/*
+ * Device info structure of results held in a result arena
+ *
+ * @see ctn::DeviceInfo
+ */
+struct ArenaDeviceInfo
+{
+    ArenaString deviceId;
+    ArenaString name;
+    ArenaString prodUniqueId;
+
+    explicit ArenaDeviceInfo(ResultArena &arena)
+        : deviceId(ArenaAllocator<char>(arena)), name(ArenaAllocator<char>(arena)), prodUniqueId(ArenaAllocator<char>(arena)) {}
+};
+
+/*
+ * Message description structure of a List Messages result held in a result arena. Optional values are held in place,
+ *  along with a flag indicating whether they have been returned
+ *
+ * @see ctn::FlatMessageDescription
+ */
+struct ArenaMessageDescription
+{
+    ArenaString messageId;
+    ArenaString action;
+    ArenaString direction;
+    bool hasFrom;
+    ArenaDeviceInfo from;
+    bool hasTo;
+    ArenaDeviceInfo to;
+    bool hasReadConfirmationEnabled;
+    bool readConfirmationEnabled;
+    bool hasRead;
+    bool read;
+    ArenaString date;
+
+    explicit ArenaMessageDescription(ResultArena &arena)
+        : messageId(ArenaAllocator<char>(arena)), action(ArenaAllocator<char>(arena)), direction(ArenaAllocator<char>(arena)),
+        hasFrom(false), from(arena), hasTo(false), to(arena), hasReadConfirmationEnabled(false), readConfirmationEnabled(false),
+        hasRead(false), read(false), date(ArenaAllocator<char>(arena)) {}
+};
+
+/*
+ * List Messages API method response structure, held in a result arena
+ *
+ * All of its data is allocated from the arena it is created with, so it must not outlive the arena, nor be used once the
+ *  arena is reset. To process successive pages of messages without allocating memory again, reset the arena and create
+ *  a new result for each page
+ *
+ * @member messages : Descriptions of the messages.
+ * @member msgCount : Number of messages for which information is returned.
+ * @member countExceeded : Was the actual number of messages greater than the max returnable.
+ *
+ * @see ctn::ResultArena
+ */
+struct ArenaListMessagesResult
+{
+    ArenaVector<ArenaMessageDescription> messages;
+    int msgCount;
+    bool countExceeded;
+
+    explicit ArenaListMessagesResult(ResultArena &arena)
+        : messages(ArenaAllocator<ArenaMessageDescription>(arena)), msgCount(0), countExceeded(false) {}
+
+    ResultArena &arena() const { return *messages.get_allocator().arena(); }
+};
+
+/*
+ * Read-only view of a string value of the data returned by an API method
+ *
+ * It refers to the raw text of the string, as it appears in the returned data, so it is only valid while the view
+ *  result it belongs to exists. Strings that contain escape sequences are only unescaped when str() is called
+ */
+class JsonStringView
+{
+private:
+    const char *data_;
+    std::size_t size_;
+    bool escaped_;
+
+public:
+    JsonStringView() : data_(""), size_(0), escaped_(false) {}
+    JsonStringView(const char *data, std::size_t size, bool escaped) : data_(data), size_(size), escaped_(escaped) {}
+
+    // Raw text of the string. It is the string value itself, unless the string is escaped
+    const char *data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // Indicates whether the raw text of the string contains escape sequences
+    bool escaped() const { return escaped_; }
+
+    // Copy of the (unescaped) string value
+    std::string str() const;
+
+    bool operator==(const std::string &value) const;
+    bool operator!=(const std::string &value) const { return !(*this == value); }
+};
+
+/*
+ * Device info structure of view results
+ *
+ * @see ctn::DeviceInfo
+ */
+struct DeviceInfoView
+{
+    JsonStringView deviceId;
+    JsonStringView name;
+    JsonStringView prodUniqueId;
+
+    // Copy of the device info as an owning structure
+    std::shared_ptr<DeviceInfo> materialize() const;
+};
+
+/*
+ * Read Message API method response structure, viewing the returned data. Optional values are held in place, along with
+ *  a flag indicating whether they have been returned
+ *
+ * It keeps the returned data alive, and its string members refer to it, so the message itself is not copied
+ *
+ * @member body : The returned data.
+ * @member action : the action performed on the message: 'log' or 'send'.
+ * @member hasFrom : Indicates whether from has been returned.
+ * @member from : Catenis ID/Name/ProdUniqueId of the origin device.
+ * @member message : the message read.
+ *
+ * @see ctn::ReadMessageResult
+ */
+struct ReadMessageView
+{
+    std::shared_ptr<const std::string> body;
+    JsonStringView action;
+    bool hasFrom;
+    DeviceInfoView from;
+    JsonStringView message;
+
+    ReadMessageView() : hasFrom(false) {}
+
+    // Copy of the data as an owning result structure
+    ReadMessageResult materialize() const;
+};
+
+/*
+ * Message description structure of view results
+ *
+ * @see ctn::FlatMessageDescription
+ */
+struct MessageDescriptionView
+{
+    JsonStringView messageId;
+    JsonStringView action;
+    JsonStringView direction;
+    bool hasFrom;
+    DeviceInfoView from;
+    bool hasTo;
+    DeviceInfoView to;
+    bool hasReadConfirmationEnabled;
+    bool readConfirmationEnabled;
+    bool hasRead;
+    bool read;
+    JsonStringView date;
+
+    MessageDescriptionView() : hasFrom(false), hasTo(false), hasReadConfirmationEnabled(false), readConfirmationEnabled(false),
+        hasRead(false), read(false) {}
+
+    // Copy of the message description as an owning structure
+    std::shared_ptr<MessageDescription> materialize() const;
+};
+
+/*
+ * List Messages API method response structure, viewing the returned data
+ *
+ * It keeps the returned data alive, and the string members of its messages refer to it. Copies of the structure share
+ *  the returned data
+ *
+ * @member body : The returned data.
+ * @member messages : Descriptions of the messages.
+ * @member msgCount : Number of messages for which information is returned.
+ * @member countExceeded : Was the actual number of messages greater than the max returnable.
+ *
+ * @see ctn::ListMessagesResult
+ */
+struct ListMessagesView
+{
+    std::shared_ptr<const std::string> body;
+    std::vector<MessageDescriptionView> messages;
+    int msgCount;
+    bool countExceeded;
+
+    ListMessagesView() : msgCount(0), countExceeded(false) {}
+
+    // Copy of the data as an owning result structure
+    ListMessagesResult materialize() const;
+};
+
 // Dictionary holding permission event description by permission event name
 typedef std::map<std::string, std::string> PermissionEventDictionary;
 
@@ -282,6 +537,55 @@ struct RetrievePermissionRightsResult
     std::shared_ptr<PermissionRightsDevice> device;
 };
 
+/*
+* Permission rights structure of results held in a result arena
+*
+* @member allowed : List of allowed entities
+* @member denied : List of denied entities
+*/
+template<typename Entry>
+struct ArenaPermissionRights
+{
+    ArenaVector<Entry> allowed;
+    ArenaVector<Entry> denied;
+
+    explicit ArenaPermissionRights(ResultArena &arena)
+        : allowed(ArenaAllocator<Entry>(arena)), denied(ArenaAllocator<Entry>(arena)) {}
+};
+
+/*
+* Retrieve Permission Rights API method response structure, held in a result arena
+*
+* All of its data is allocated from the arena it is created with, so it must not outlive the arena, nor be used once the
+*  arena is reset. Permission rights that have not been returned are flagged as such, and left empty
+*
+* @member system : Permission right set at the system level.
+* @member hasCatenisNode : Indicates whether permission rights are set at catenisNodes level
+* @member catenisNode : Permission rights set at catenisNodes level
+* @member hasClient : Indicates whether permission rights are set at client level
+* @member client : Permission rights set at client level
+* @member hasDevice : Indicates whether permission rights are set at device level
+* @member device : Permission rights set at device level
+*
+* @see ctn::ResultArena
+*/
+struct ArenaRetrievePermissionRightsResult
+{
+    ArenaString system;
+    bool hasCatenisNode;
+    ArenaPermissionRights<ArenaString> catenisNode;
+    bool hasClient;
+    ArenaPermissionRights<ArenaString> client;
+    bool hasDevice;
+    ArenaPermissionRights<ArenaDeviceInfo> device;
+
+    explicit ArenaRetrievePermissionRightsResult(ResultArena &arena)
+        : system(ArenaAllocator<char>(arena)), hasCatenisNode(false), catenisNode(arena), hasClient(false), client(arena),
+        hasDevice(false), device(arena) {}
+
+    ResultArena &arena() const { return *system.get_allocator().arena(); }
+};
+
 /*
 * Set Permission Rights at Device Level structure (Array of Objects)
 *
@@ -416,6 +720,390 @@ struct DeviceIdInfoResult
 
 
 
+/*
+ * Connection pool options structure
+ *
+ * @member maxIdleConnections : Maximum number of idle (keep-alive) connections kept open for reuse
+ * @member maxActiveConnections : Maximum number of connections that can be in use at the same time (0: no limit)
+ * @member idleTimeout : Time, in seconds, after which an unused idle connection is closed
+ */
+struct ConnectionPoolOptions
+{
+    unsigned int maxIdleConnections;
+    unsigned int maxActiveConnections;
+    unsigned int idleTimeout;
+
+    // Default constructor with default values for members
+    ConnectionPoolOptions()
+    {
+        maxIdleConnections = 4;
+        maxActiveConnections = 8;
+        idleTimeout = 30;
+    }
+
+    ConnectionPoolOptions(unsigned int max_idle_connections, unsigned int max_active_connections, unsigned int idle_timeout)
+        : maxIdleConnections(max_idle_connections), maxActiveConnections(max_active_connections), idleTimeout(idle_timeout) {}
+};
+
+/*
+ * Request timeouts structure
+ *
+ * All times are in milliseconds. A value of 0 means no limit
+ *
+ * @member connect : Time allowed to open the connection to the server
+ * @member tlsHandshake : Time allowed to complete the TLS handshake (secure connections only). With the Poco library, it
+ *  is added to the time allowed to open the connection, since both take place in a single step
+ * @member send : Time allowed to send the request
+ * @member receive : Time allowed to receive the response
+ * @member deadline : Overall time allowed for the request, including the time spent waiting for a connection to become
+ *  available, and all its retries. Retries that could not start before it are not attempted
+ */
+struct RequestTimeouts
+{
+    unsigned int connect;
+    unsigned int tlsHandshake;
+    unsigned int send;
+    unsigned int receive;
+    unsigned int deadline;
+
+    // Default constructor with default values for members
+    RequestTimeouts()
+    {
+        connect = 10000;
+        tlsHandshake = 10000;
+        send = 30000;
+        receive = 60000;
+        deadline = 0;
+    }
+
+    RequestTimeouts(unsigned int connect_timeout, unsigned int tls_handshake_timeout, unsigned int send_timeout, unsigned int receive_timeout, unsigned int deadline_arg = 0)
+        : connect(connect_timeout), tlsHandshake(tls_handshake_timeout), send(send_timeout), receive(receive_timeout), deadline(deadline_arg) {}
+};
+
+/*
+ * Retry options structure
+ *
+ * Only requests of API methods that do not change any state (the ones that use the HTTP GET method) are retried, and
+ *  only when they fail with an error that may go away by itself: a connection error, a timeout, or an HTTP status code
+ *  of 408, 429, 500, 502, 503 or 504. The time waited before each retry is picked at random, so that clients that failed
+ *  at the same time do not retry all at once
+ *
+ * @member maxAttempts : Maximum number of attempts made for each request (1: no retries)
+ * @member baseDelay : Minimum time, in milliseconds, waited before retrying a request
+ * @member maxDelay : Maximum time, in milliseconds, waited before retrying a request
+ * @member budget : Maximum number of retries that can be saved up. Once they are used up, failed requests are not
+ *  retried until enough new requests have been made
+ * @member budgetRatio : Number of retries (usually a fraction of one) added to the budget by each new request
+ */
+struct RetryOptions
+{
+    unsigned int maxAttempts;
+    unsigned int baseDelay;
+    unsigned int maxDelay;
+    unsigned int budget;
+    double budgetRatio;
+
+    // Default constructor with default values for members
+    RetryOptions()
+    {
+        maxAttempts = 3;
+        baseDelay = 100;
+        maxDelay = 5000;
+        budget = 10;
+        budgetRatio = 0.1;
+    }
+
+    RetryOptions(unsigned int max_attempts, unsigned int base_delay, unsigned int max_delay, unsigned int budget_arg = 10, double budget_ratio = 0.1)
+        : maxAttempts(max_attempts), baseDelay(base_delay), maxDelay(max_delay), budget(budget_arg), budgetRatio(budget_ratio) {}
+};
+
+/*
+ * Request scheduler options structure
+ *
+ * When enabled, requests that exceed the rate or the concurrency limit are queued, and sent as soon as they fall within
+ *  the limits. Queued requests are sent in order of priority: requests of API methods that only retrieve data first,
+ *  then the other requests, and lastly the requests of batch API method calls
+ *
+ * @member requestsPerSecond : Sustained number of requests that can be sent per second (0: no limit)
+ * @member burst : Number of requests that can be sent at once after a quiet period. If 0, the requests per second
+ *  (rounded up) is used
+ * @member maxConcurrent : Maximum number of requests in progress at the same time (0: no limit)
+ */
+struct SchedulerOptions
+{
+    double requestsPerSecond;
+    unsigned int burst;
+    unsigned int maxConcurrent;
+
+    // Default constructor with default values for members (scheduler disabled)
+    SchedulerOptions()
+    {
+        requestsPerSecond = 0;
+        burst = 0;
+        maxConcurrent = 0;
+    }
+
+    SchedulerOptions(double requests_per_second, unsigned int burst_arg = 0, unsigned int max_concurrent = 0)
+        : requestsPerSecond(requests_per_second), burst(burst_arg), maxConcurrent(max_concurrent) {}
+};
+
+/*
+ * Result cache options structure
+ *
+ * Messages and message containers do not change once they are recorded, so they can be kept in memory and returned again
+ *  without contacting the Catenis API server. Containers whose blockchain transaction is not yet confirmed are not
+ *  kept. Note that reading a cached message does not get it marked as read again on the server
+ *
+ * @member maxMessages : Maximum number of messages (of Read Message calls) kept (0: messages are not cached)
+ * @member maxContainers : Maximum number of message containers (of Retrieve Message Container calls) kept (0:
+ *  containers are not cached)
+ * @member filePath : Path of the file where messages and message containers are also kept, so they survive restarts
+ *  of the application ("": no persistent cache). The file should not be shared by clients that exist at the same time.
+ *  Its contents are discarded when it is opened by a client of another device, or for another API server
+ * @member maxFileSize : Maximum size, in bytes, of that file. Once it is reached, no more results are added to it
+ */
+struct ResultCacheOptions
+{
+    unsigned int maxMessages;
+    unsigned int maxContainers;
+    std::string filePath;
+    unsigned long long maxFileSize;
+
+    // Default constructor with default values for members (cache disabled)
+    ResultCacheOptions()
+    {
+        maxMessages = 0;
+        maxContainers = 0;
+        maxFileSize = 256ULL * 1024 * 1024;
+    }
+
+    ResultCacheOptions(unsigned int max_messages, unsigned int max_containers, std::string file_path = "", unsigned long long max_file_size = 256ULL * 1024 * 1024)
+        : maxMessages(max_messages), maxContainers(max_containers), filePath(file_path), maxFileSize(max_file_size) {}
+};
+
+/*
+ * Override of the client's request timeouts
+ *
+ * While it exists, the API method calls issued from the thread that created it use its timeouts instead of the ones
+ *  set through the client options. Overrides can be nested, the innermost one being used
+ *
+ * @see ctn::RequestTimeouts
+ */
+class RequestTimeoutsOverride
+{
+private:
+    RequestTimeouts timeouts_;
+    const RequestTimeoutsOverride *previous_;
+
+public:
+    explicit RequestTimeoutsOverride(const RequestTimeouts &timeouts);
+    ~RequestTimeoutsOverride();
+
+    RequestTimeoutsOverride(const RequestTimeoutsOverride &) = delete;
+    RequestTimeoutsOverride &operator=(const RequestTimeoutsOverride &) = delete;
+
+    const RequestTimeouts &timeouts() const { return timeouts_; }
+
+    // Innermost override in effect for the calling thread, or nullptr if there is none
+    static const RequestTimeoutsOverride *current();
+};
+
+/*
+ * Client options structure
+ *
+ * @member connectionPool : Options for the pool of keep-alive connections to the Catenis API server
+ * @member timeouts : Time allowed for each request, and for each of its phases
+ * @member retry : Options for retrying failed requests
+ * @member scheduler : Options for limiting the rate and concurrency of the requests sent to the Catenis API server
+ * @member resultCache : Options for keeping the results of API methods that always return the same data
+ * @member asyncThreads : Number of threads used to run asynchronous API method calls. Only used with the Poco
+ *  library, where each in-flight request occupies one thread (with Boost Asio a single I/O thread drives all requests)
+ * @member streamingJsonParsing : Indicates whether the returned data should be read in a single pass, straight into
+ *  the result structures. If not, or if the returned data cannot be read that way, a JSON document tree is built first
+ * @member dnsCacheTtl : Time, in seconds, after which the cached addresses of the server are looked up again, in the
+ *  background (0: no caching, addresses are looked up whenever a connection is opened)
+ * @member shareDeviceInfo : Indicates whether the results of Read Message, List Messages and Retrieve Permission Rights
+ *  calls that refer to the same device should share a single device info structure, so devices can be compared by
+ *  pointer. Shared device info structures must not be modified
+ */
+struct ClientOptions
+{
+    ConnectionPoolOptions connectionPool;
+    RequestTimeouts timeouts;
+    RetryOptions retry;
+    SchedulerOptions scheduler;
+    ResultCacheOptions resultCache;
+    unsigned int asyncThreads;
+    bool streamingJsonParsing;
+    unsigned int dnsCacheTtl;
+    bool shareDeviceInfo;
+
+    // Default constructor with default values for members
+    ClientOptions()
+    {
+        asyncThreads = 4;
+        streamingJsonParsing = true;
+        dnsCacheTtl = 60;
+        shareDeviceInfo = false;
+    }
+};
+
+/*
+ * TLS session statistics structure
+ *
+ * @member handshakes : Number of TLS handshakes successfully completed when opening connections
+ * @member resumedHandshakes : Number of those handshakes that resumed a previous TLS session (abbreviated handshakes)
+ */
+struct TlsSessionStats
+{
+    unsigned long handshakes;
+    unsigned long resumedHandshakes;
+
+    TlsSessionStats() : handshakes(0), resumedHandshakes(0) {}
+
+    // Fraction of handshakes that resumed a previous TLS session
+    double hitRate() const
+    {
+        return handshakes > 0 ? static_cast<double>(resumedHandshakes) / handshakes : 0.0;
+    }
+};
+
+/*
+ * Request scheduler statistics structure
+ *
+ * @member queueDepth : Number of requests currently waiting to be sent
+ * @member readQueueDepth : Number of those requests that only retrieve data
+ * @member writeQueueDepth : Number of those requests that are not part of a batch API method call, and do not only
+ *  retrieve data
+ * @member bulkQueueDepth : Number of those requests that are part of a batch API method call
+ * @member peakQueueDepth : Largest number of requests that have been waiting to be sent at the same time
+ * @member inFlight : Number of requests currently in progress
+ * @member queuedRequests : Total number of requests that had to wait before being sent
+ */
+struct SchedulerStats
+{
+    unsigned long queueDepth;
+    unsigned long readQueueDepth;
+    unsigned long writeQueueDepth;
+    unsigned long bulkQueueDepth;
+    unsigned long peakQueueDepth;
+    unsigned long inFlight;
+    unsigned long queuedRequests;
+
+    SchedulerStats() : queueDepth(0), readQueueDepth(0), writeQueueDepth(0), bulkQueueDepth(0), peakQueueDepth(0), inFlight(0), queuedRequests(0) {}
+};
+
+/*
+ * Result cache statistics structure
+ *
+ * @member messageHits : Number of Read Message calls served from the cache
+ * @member messageMisses : Number of Read Message calls not found in the cache
+ * @member containerHits : Number of Retrieve Message Container calls served from the cache
+ * @member containerMisses : Number of Retrieve Message Container calls not found in the cache
+ * @member persistentHits : Number of the calls served from the cache whose result was read from the persistent cache
+ *  file
+ */
+struct ResultCacheStats
+{
+    unsigned long messageHits;
+    unsigned long messageMisses;
+    unsigned long containerHits;
+    unsigned long containerMisses;
+    unsigned long persistentHits;
+
+    ResultCacheStats() : messageHits(0), messageMisses(0), containerHits(0), containerMisses(0), persistentHits(0) {}
+};
+
+/*
+ * Callback invoked when an asynchronous API method call completes. It is called from the client's I/O thread, so it
+ *  should return quickly and it must not call any synchronous API method
+ *
+ * @param error : Exception (derived from ctn::CatenisAPIException) raised by the call, or nullptr on success
+ * @param data : The data returned by the API method. Only meaningful when no error is reported
+ */
+template<typename Result>
+using ApiCallback = std::function<void(std::exception_ptr error, Result &data)>;
+
+/*
+ * Outcome of a single item of a batch API method call
+ *
+ * @member data : The data returned by the API method for that item. Only meaningful when no error is reported
+ * @member error : Exception (derived from ctn::CatenisAPIException) raised for that item, or nullptr on success
+ */
+template<typename Result>
+struct BatchItemResult
+{
+    Result data;
+    std::exception_ptr error;
+};
+
+class CtnApiClient;
+
+/*
+ * Iterator over all the messages that match a given criteria, however many of them there are
+ *
+ * Messages are retrieved by time frame. When a time frame holds more messages than the Catenis API server can return at
+ *  once, it is split in two halves, which are retrieved in turn. The messages of the next time frame are retrieved in
+ *  the background while the ones of the current time frame are consumed, so at most two lists of messages are held at
+ *  any time. Both boundaries of each time frame are inclusive, with millisecond precision.
+ *
+ * A time frame of a single millisecond cannot be split any further. If it still holds more messages than can be
+ *  returned at once, only the returned ones are iterated over, and countExceeded() reports that some were left out.
+ *
+ * The client it was created from must outlive it. Since next() waits for the messages to be retrieved, it must not be
+ *  called from an asynchronous API method callback
+ *
+ * @see ctn::CtnApiClient::iterateMessages
+ */
+class MessageIterator
+{
+private:
+    // Time frame, in milliseconds since the Unix epoch
+    struct TimeFrame
+    {
+        long long start;
+        long long end;
+    };
+
+    CtnApiClient *client_;
+    std::string action_;
+    std::string direction_;
+    std::string from_device_ids_;
+    std::string to_device_ids_;
+    std::string from_device_prod_ids_;
+    std::string to_device_prod_ids_;
+    std::string read_state_;
+
+    // Time frames not yet requested, the earliest one last
+    std::vector<TimeFrame> frames_;
+    // Request in progress, if any, and its time frame
+    std::future<ListMessagesResult> pending_;
+    TimeFrame pending_frame_;
+    // Messages of the current time frame not yet consumed
+    std::list< std::shared_ptr<MessageDescription> > messages_;
+    bool count_exceeded_;
+
+    void requestNextFrame();
+
+public:
+    // Throws ctn::CatenisClientError if a date is not ISO 8601 formatted
+    MessageIterator(CtnApiClient &client, std::string action, std::string direction, std::string from_device_ids, std::string to_device_ids, std::string from_device_prod_ids, std::string to_device_prod_ids, std::string read_state, std::string start_date, std::string end_date);
+
+    /*
+     * Get the next message
+     *
+     * @param[out] message : The next message
+     *
+     * @return false if there are no more messages. If retrieving the messages fails, the error raised by the call is
+     *  rethrown, and no more messages are returned
+     */
+    bool next(std::shared_ptr<MessageDescription> &message);
+
+    // Indicates whether some messages have been left out, since a time frame of a single millisecond held more messages
+    //  than could be returned at once. Once set, it stays set
+    bool countExceeded() const { return count_exceeded_; }
+};
+
 // Forward declare internals
 class CtnApiInternals;
 
@@ -442,8 +1130,11 @@ public:
      * ["prod"|"sandbox"]
      * @param[in] secure (optional, default: true) :  Indicates whether a secure connection (HTTPS) should be used
      * @param[in] version (optional, default: DEFAULT_API_VERSION) :  Version of Catenis API to target
+     * @param[in] options (optional) :  Client options
+     *
+     * @see ctn::ClientOptions
      */
-    CtnApiClient(std::string device_id, std::string api_access_secret, std::string host = "catenis.io", std::string port = "",std::string environment = "prod", bool secure = true, std::string version = DEFAULT_API_VERSION);
+    CtnApiClient(std::string device_id, std::string api_access_secret, std::string host = "catenis.io", std::string port = "",std::string environment = "prod", bool secure = true, std::string version = DEFAULT_API_VERSION, const ClientOptions &options = ClientOptions());
     
     /* Destructor */
     ~CtnApiClient();
@@ -458,8 +1149,41 @@ public:
      * @see ctn::LogMessageResult
      * @see ctn::MessageOptions
      */
-    void logMessage(LogMessageResult &data, std::string message, const MessageOptions &option = MessageOptions());
-    
+    void logMessage(LogMessageResult &data, const std::string &message, const MessageOptions &option = MessageOptions());
+
+    /*
+     * Log a message asynchronously
+     *
+     * @param[in] callback : Function called with the returned data once the request completes
+     * @param[in] message : The messsage to store
+     * @param[in] option (optional) :  Options to log message
+     *
+     * @return (future variant) Future that holds the returned data, or rethrows the error raised by the call
+     *
+     * @see ctn::LogMessageResult
+     * @see ctn::ApiCallback
+     */
+    std::future<LogMessageResult> logMessageAsync(const std::string &message, const MessageOptions &option = MessageOptions());
+    void logMessageAsync(ApiCallback<LogMessageResult> callback, const std::string &message, const MessageOptions &option = MessageOptions());
+
+    /*
+     * Log a batch of messages
+     *
+     * The individual requests are issued concurrently over the client's keep-alive connections, keeping at most
+     *  max_in_flight of them in progress at any time. The call returns once every message has been processed
+     *
+     * @param[out] data : The outcome of each message, in the same order as the messages
+     * @param[in] messages : The messages to store
+     * @param[in] option (optional) :  Options to log the messages
+     * @param[in] max_in_flight (optional, default: 0) :  Maximum number of requests in progress at the same time
+     *  (0: use the maximum number of active connections of the connection pool)
+     *
+     * @see ctn::BatchItemResult
+     * @see ctn::LogMessageResult
+     * @see ctn::MessageOptions
+     */
+    void logMessages(std::vector< BatchItemResult<LogMessageResult> > &data, const std::vector<std::string> &messages, const MessageOptions &option = MessageOptions(), unsigned int max_in_flight = 0);
+
     /*
      * Send a message
      *
@@ -472,7 +1196,44 @@ public:
      * @see ctn::Device
      * @see ctn::MessageOptions
      */
-    void sendMessage(SendMessageResult &data, const Device &device, std::string message, const MessageOptions &option = MessageOptions());
+    void sendMessage(SendMessageResult &data, const Device &device, const std::string &message, const MessageOptions &option = MessageOptions());
+
+    /*
+     * Send a message asynchronously
+     *
+     * @param[in] callback : Function called with the returned data once the request completes
+     * @param[in] device : Device that receives message
+     * @param[in] message : The messsage to send
+     * @param[in] option (optional) :  Options to send message
+     *
+     * @return (future variant) Future that holds the returned data, or rethrows the error raised by the call
+     *
+     * @see ctn::SendMessageResult
+     * @see ctn::ApiCallback
+     */
+    std::future<SendMessageResult> sendMessageAsync(const Device &device, const std::string &message, const MessageOptions &option = MessageOptions());
+    void sendMessageAsync(ApiCallback<SendMessageResult> callback, const Device &device, const std::string &message, const MessageOptions &option = MessageOptions());
+
+    /*
+     * Send a message to several devices
+     *
+     * One request is issued per target device. The requests are issued concurrently over the client's keep-alive
+     *  connections, keeping at most max_parallel of them in progress at any time. The call returns once the message
+     *  has been sent to every device
+     *
+     * @param[out] data : The outcome for each target device, in the same order as the devices
+     * @param[in] devices : Devices that receive message
+     * @param[in] message : The messsage to send
+     * @param[in] option (optional) :  Options to send message
+     * @param[in] max_parallel (optional, default: 0) :  Maximum number of requests in progress at the same time
+     *  (0: use the maximum number of active connections of the connection pool)
+     *
+     * @see ctn::BatchItemResult
+     * @see ctn::SendMessageResult
+     * @see ctn::Device
+     * @see ctn::MessageOptions
+     */
+    void sendMessage(std::vector< BatchItemResult<SendMessageResult> > &data, const std::vector<Device> &devices, const std::string &message, const MessageOptions &option = MessageOptions(), unsigned int max_parallel = 0);
     
     /*
      * Read a message
@@ -486,6 +1247,33 @@ public:
      *
      */
     void readMessage(ReadMessageResult &data, std::string message_id, std::string encoding = "utf8");
+
+    /*
+     * Read a message, viewing the returned data instead of copying it into an owning structure. The result cache, if
+     *  enabled, is not used
+     *
+     * @param[out] data : The data to parse response into
+     *
+     * Remaining parameters are the same as for the other variant
+     *
+     * @see ctn::ReadMessageView
+     */
+    void readMessage(ReadMessageView &data, std::string message_id, std::string encoding = "utf8");
+
+    /*
+     * Read a message asynchronously
+     *
+     * @param[in] callback : Function called with the returned data once the request completes
+     * @param[in] message_id : ID of message to read
+     * @param[in] encoding (optional, default: "utf8") :  The encoding that should be used for the returned message
+     *
+     * @return (future variant) Future that holds the returned data, or rethrows the error raised by the call
+     *
+     * @see ctn::ReadMessageResult
+     * @see ctn::ApiCallback
+     */
+    std::future<ReadMessageResult> readMessageAsync(std::string message_id, std::string encoding = "utf8");
+    void readMessageAsync(ApiCallback<ReadMessageResult> callback, std::string message_id, std::string encoding = "utf8");
     
     /*
      * Retrieve message container
@@ -497,6 +1285,20 @@ public:
      *
      */
     void retrieveMessageContainer(RetrieveMessageContainerResult &data, std::string message_id);
+
+    /*
+     * Retrieve message container asynchronously
+     *
+     * @param[in] callback : Function called with the returned data once the request completes
+     * @param[in] message_id : ID of message to retrieve container info
+     *
+     * @return (future variant) Future that holds the returned data, or rethrows the error raised by the call
+     *
+     * @see ctn::RetrieveMessageContainerResult
+     * @see ctn::ApiCallback
+     */
+    std::future<RetrieveMessageContainerResult> retrieveMessageContainerAsync(std::string message_id);
+    void retrieveMessageContainerAsync(ApiCallback<RetrieveMessageContainerResult> callback, std::string message_id);
     
     /*
      * Retrieves a list of message entries filtered by a given criteria
@@ -520,6 +1322,86 @@ public:
      */
     void listMessages(ListMessagesResult &data, std::string action = "any", std::string direction = "any", std::string from_device_ids = "", std::string to_device_ids = "", std::string from_device_prod_ids = "", std::string to_device_prod_ids = "", std::string read_state = "any", std::string start_date = "", std::string endDate = "");
 
+    /*
+     * Retrieves a list of message entries filtered by a given criteria, into a flat result: message descriptions are
+     *  held by value in a single array, and the devices they refer to are listed once in a device table
+     *
+     * @param[out] data : The data to parse response into
+     *
+     * Remaining parameters are the same as for the other variant
+     *
+     * @see ctn::FlatListMessagesResult
+     */
+    void listMessages(FlatListMessagesResult &data, std::string action = "any", std::string direction = "any", std::string from_device_ids = "", std::string to_device_ids = "", std::string from_device_prod_ids = "", std::string to_device_prod_ids = "", std::string read_state = "any", std::string start_date = "", std::string endDate = "");
+
+    /*
+     * Retrieves a list of message entries filtered by a given criteria, into a result held in a result arena
+     *
+     * @param[out] data : The data to parse response into. Its previous contents are discarded
+     *
+     * Remaining parameters are the same as for the other variants
+     *
+     * @see ctn::ArenaListMessagesResult
+     */
+    void listMessages(ArenaListMessagesResult &data, std::string action = "any", std::string direction = "any", std::string from_device_ids = "", std::string to_device_ids = "", std::string from_device_prod_ids = "", std::string to_device_prod_ids = "", std::string read_state = "any", std::string start_date = "", std::string endDate = "");
+
+    /*
+     * Retrieves a list of message entries filtered by a given criteria, viewing the returned data instead of copying it
+     *  into owning structures
+     *
+     * @param[out] data : The data to parse response into
+     *
+     * Remaining parameters are the same as for the other variants
+     *
+     * @see ctn::ListMessagesView
+     */
+    void listMessages(ListMessagesView &data, std::string action = "any", std::string direction = "any", std::string from_device_ids = "", std::string to_device_ids = "", std::string from_device_prod_ids = "", std::string to_device_prod_ids = "", std::string read_state = "any", std::string start_date = "", std::string endDate = "");
+
+    /*
+     * Retrieves a list of message entries filtered by a given criteria asynchronously
+     *
+     * @param[in] callback : Function called with the returned data once the request completes
+     *
+     * Remaining parameters are the same as for listMessages()
+     *
+     * @return (future variant) Future that holds the returned data, or rethrows the error raised by the call
+     *
+     * @see ctn::ListMessagesResult
+     * @see ctn::ApiCallback
+     */
+    std::future<ListMessagesResult> listMessagesAsync(std::string action = "any", std::string direction = "any", std::string from_device_ids = "", std::string to_device_ids = "", std::string from_device_prod_ids = "", std::string to_device_prod_ids = "", std::string read_state = "any", std::string start_date = "", std::string endDate = "");
+    void listMessagesAsync(ApiCallback<ListMessagesResult> callback, std::string action = "any", std::string direction = "any", std::string from_device_ids = "", std::string to_device_ids = "", std::string from_device_prod_ids = "", std::string to_device_prod_ids = "", std::string read_state = "any", std::string start_date = "", std::string endDate = "");
+
+    /*
+     * Iterate over all the message entries filtered by a given criteria, splitting the time frame as needed so no
+     *  messages are left out because there are too many of them
+     *
+     * Parameters are the same as for listMessages(). If no start date is given, messages are retrieved from the Unix
+     *  epoch on. If no end date is given, messages are retrieved up to the time the iterator is created. Dates without
+     *  a time zone are taken as UTC
+     *
+     * @return Iterator that returns the messages one at a time
+     *
+     * @see ctn::MessageIterator
+     */
+    MessageIterator iterateMessages(std::string action = "any", std::string direction = "any", std::string from_device_ids = "", std::string to_device_ids = "", std::string from_device_prod_ids = "", std::string to_device_prod_ids = "", std::string read_state = "any", std::string start_date = "", std::string end_date = "");
+
+    /*
+     * Retrieve all the message entries filtered by a given criteria, splitting the time frame into shards that are
+     *  retrieved concurrently over the client's keep-alive connections. Shards that hold more messages than the Catenis
+     *  API server can return at once are split further, as many times as needed
+     *
+     * @param[out] data : The data to parse response into. Messages are in date order, without duplicates. Its
+     *  countExceeded member is only set if a time frame of a single millisecond held too many messages
+     * @param[in] max_in_flight (optional, default: 0) :  Number of shards the time frame is split into, and maximum number
+     *  of requests in progress at the same time (0: use the maximum number of active connections of the connection pool)
+     *
+     * Remaining parameters are the same as for iterateMessages()
+     *
+     * @see ctn::ListMessagesResult
+     */
+    void scanMessages(ListMessagesResult &data, std::string action = "any", std::string direction = "any", std::string from_device_ids = "", std::string to_device_ids = "", std::string from_device_prod_ids = "", std::string to_device_prod_ids = "", std::string read_state = "any", std::string start_date = "", std::string end_date = "", unsigned int max_in_flight = 0);
+
     /*
     * List Permission Events
     *
@@ -530,6 +1412,19 @@ public:
     */
     void listPermissionEvents(ListPermissionEventsResult &data);
 
+    /*
+    * List Permission Events asynchronously
+    *
+    * @param[in] callback : Function called with the returned data once the request completes
+    *
+    * @return (future variant) Future that holds the returned data, or rethrows the error raised by the call
+    *
+    * @see ctn::ListPermissionEventsResult
+    * @see ctn::ApiCallback
+    */
+    std::future<ListPermissionEventsResult> listPermissionEventsAsync();
+    void listPermissionEventsAsync(ApiCallback<ListPermissionEventsResult> callback);
+
     /*
     * Retrieve Permission Rights
     *
@@ -542,6 +1437,30 @@ public:
     */
     void retrievePermissionRights(RetrievePermissionRightsResult &data, std::string eventName);
 
+    /*
+    * Retrieve Permission Rights, into a result held in a result arena
+    *
+    * @param[out] data : The data to parse response into. Its previous contents are discarded
+    * @param[in] eventName : Name of the permission event to lookup
+    *
+    * @see ctn::ArenaRetrievePermissionRightsResult
+    */
+    void retrievePermissionRights(ArenaRetrievePermissionRightsResult &data, std::string eventName);
+
+    /*
+    * Retrieve Permission Rights asynchronously
+    *
+    * @param[in] callback : Function called with the returned data once the request completes
+    * @param[in] eventName : Name of the permission event to lookup
+    *
+    * @return (future variant) Future that holds the returned data, or rethrows the error raised by the call
+    *
+    * @see ctn::RetrievePermissionRightsResult
+    * @see ctn::ApiCallback
+    */
+    std::future<RetrievePermissionRightsResult> retrievePermissionRightsAsync(std::string eventName);
+    void retrievePermissionRightsAsync(ApiCallback<RetrievePermissionRightsResult> callback, std::string eventName);
+
     /*
     * Set Permission Rights
     *
@@ -558,6 +1477,21 @@ public:
     */
     void setPermissionRights(SetPermissionRightsResult &data, std::string eventName, std::string systemRight, SetRightsCtnNode *cntNodesRights, SetRightsClient *clientRights, SetRightsDevice *deviceRights);
 
+    /*
+    * Set Permission Rights asynchronously. The supplied rights are only accessed before the method returns
+    *
+    * @param[in] callback : Function called with the returned data once the request completes
+    *
+    * Remaining parameters are the same as for setPermissionRights()
+    *
+    * @return (future variant) Future that holds the returned data, or rethrows the error raised by the call
+    *
+    * @see ctn::SetPermissionRightsResult
+    * @see ctn::ApiCallback
+    */
+    std::future<SetPermissionRightsResult> setPermissionRightsAsync(std::string eventName, std::string systemRight, SetRightsCtnNode *cntNodesRights, SetRightsClient *clientRights, SetRightsDevice *deviceRights);
+    void setPermissionRightsAsync(ApiCallback<SetPermissionRightsResult> callback, std::string eventName, std::string systemRight, SetRightsCtnNode *cntNodesRights, SetRightsClient *clientRights, SetRightsDevice *deviceRights);
+
     /*
     * List Notification Events
     *
@@ -570,6 +1504,19 @@ public:
     */
     void listNotificationEvents(ListNotificationEventsResult &data);
 
+    /*
+    * List Notification Events asynchronously
+    *
+    * @param[in] callback : Function called with the returned data once the request completes
+    *
+    * @return (future variant) Future that holds the returned data, or rethrows the error raised by the call
+    *
+    * @see ctn::ListNotificationEventsResult
+    * @see ctn::ApiCallback
+    */
+    std::future<ListNotificationEventsResult> listNotificationEventsAsync();
+    void listNotificationEventsAsync(ApiCallback<ListNotificationEventsResult> callback);
+
     /*
     * Check Effective Permission Right
     *
@@ -588,6 +1535,21 @@ public:
     */
     void checkEffectivePermissionRight(CheckEffectivePermissionRightResult &data, std::string eventName, Device device);
 
+    /*
+    * Check Effective Permission Right asynchronously
+    *
+    * @param[in] callback : Function called with the returned data once the request completes
+    * @param[in] event name : Name of the permission event to lookup
+    * @param[in] device : The virtual device the permission right applied to which should be retrieved
+    *
+    * @return (future variant) Future that holds the returned data, or rethrows the error raised by the call
+    *
+    * @see ctn::CheckEffectivePermissionRightResult
+    * @see ctn::ApiCallback
+    */
+    std::future<CheckEffectivePermissionRightResult> checkEffectivePermissionRightAsync(std::string eventName, Device device);
+    void checkEffectivePermissionRightAsync(ApiCallback<CheckEffectivePermissionRightResult> callback, std::string eventName, Device device);
+
     /*
     * Retrieve Device Identification Info
     *
@@ -603,6 +1565,51 @@ public:
     *
     */
     void retrieveDeviceIdInfo(DeviceIdInfoResult &data, Device device);
+
+    /*
+    * Retrieve Device Identification Info asynchronously
+    *
+    * @param[in] callback : Function called with the returned data once the request completes
+    * @param[in] device : The virtual device for which identification info should be retrieved
+    *
+    * @return (future variant) Future that holds the returned data, or rethrows the error raised by the call
+    *
+    * @see ctn::DeviceIdInfoResult
+    * @see ctn::ApiCallback
+    */
+    std::future<DeviceIdInfoResult> retrieveDeviceIdInfoAsync(Device device);
+    void retrieveDeviceIdInfoAsync(ApiCallback<DeviceIdInfoResult> callback, Device device);
+
+    /*
+     * Get statistics of the TLS sessions used by the connections to the Catenis API server. Connections that are
+     *  reopened (after being idle for too long, or closed by the server) resume the last TLS session when possible
+     *
+     * @return TLS session statistics. All zeros if secure connections are not used
+     *
+     * @see ctn::TlsSessionStats
+     */
+    TlsSessionStats getTlsSessionStats();
+
+    /*
+     * Get statistics of the request scheduler, which limits the rate and concurrency of the requests sent to the
+     *  Catenis API server
+     *
+     * @return Request scheduler statistics. All zeros if the scheduler is not enabled
+     *
+     * @see ctn::SchedulerStats
+     * @see ctn::SchedulerOptions
+     */
+    SchedulerStats getSchedulerStats();
+
+    /*
+     * Get statistics of the cache of API method results
+     *
+     * @return Result cache statistics. All zeros if the cache is not enabled
+     *
+     * @see ctn::ResultCacheStats
+     * @see ctn::ResultCacheOptions
+     */
+    ResultCacheStats getResultCacheStats();
 };
 
 }
@@ -0,0 +1,172 @@
+//
+//  CatenisApiConnectionPool.h
+//  CatenisAPIClientCpp
+//
+#ifndef __CATENISAPICONNECTIONPOOL_H__
+#define __CATENISAPICONNECTIONPOOL_H__
+
+#include <string>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <functional>
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl/context.hpp>
+#include <boost/asio/ssl/stream.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#elif defined(COM_SUPPORT_LIB_POCO)
+#include <condition_variable>
+#include <Poco/Net/Context.h>
+#include <Poco/Net/Session.h>
+#include <Poco/Net/HTTPClientSession.h>
+#endif
+
+#include <CatenisApiClient.h>
+
+namespace ctn
+{
+
+class CtnApiResolver;
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+// Phases of a request that can time out. They are reported as errors of the timeout category, whose message is the
+//  name of the phase
+enum class TimeoutPhase
+{
+    connect = 1,
+    tlsHandshake,
+    send,
+    receive,
+    deadline
+};
+
+const boost::system::error_category &timeoutCategory();
+boost::system::error_code makeTimeoutError(TimeoutPhase phase);
+#endif
+
+/*
+ * Keep-alive HTTP/1.1 connection to the Catenis API server
+ *
+ * @member reused : Indicates whether the connection has already served a previous request
+ * @member lastUsed : Time when the connection was last returned to the pool
+ */
+struct CtnApiConnection
+{
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    std::unique_ptr<boost::asio::ip::tcp::socket> socket;
+    std::unique_ptr<boost::asio::ssl::stream<boost::asio::ip::tcp::socket> > sslStream;
+    // Kept with the connection since it may hold bytes read past the end of the last response
+    boost::beast::flat_buffer buffer;
+
+    boost::asio::ip::tcp::socket &lowestLayer()
+    {
+        return sslStream ? sslStream->next_layer() : *socket;
+    }
+#elif defined(COM_SUPPORT_LIB_POCO)
+    std::unique_ptr<Poco::Net::HTTPClientSession> session;
+#endif
+    bool reused;
+    std::chrono::steady_clock::time_point lastUsed;
+
+    CtnApiConnection() : reused(false) {}
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    ~CtnApiConnection()
+    {
+        // Connections are closed without exchanging close_notify alerts. Flag the TLS connection as shut down so that
+        //  OpenSSL does not make its session non-resumable because of that (a session is still invalidated by OpenSSL
+        //  itself if its connection fails with a TLS alert)
+        if (sslStream) {
+            SSL_set_shutdown(sslStream->native_handle(), SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+        }
+    }
+#endif
+};
+
+class CtnApiConnectionPool
+{
+public:
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    typedef std::function<void(const boost::system::error_code &ec, std::unique_ptr<CtnApiConnection> connection)> AcquireHandler;
+#endif
+
+private:
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    // Request waiting for a connection, with the time allowed to open it
+    struct Waiter
+    {
+        RequestTimeouts timeouts;
+        AcquireHandler handler;
+
+        Waiter(const RequestTimeouts &timeouts_arg, AcquireHandler handler_arg) : timeouts(timeouts_arg), handler(handler_arg) {}
+    };
+#endif
+
+    std::string host_;
+    std::string port_;
+    bool secure_;
+    ConnectionPoolOptions options_;
+    CtnApiResolver &resolver_;
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    boost::asio::io_context &ioc_;
+    // TLS context shared by all connections, built once
+    boost::asio::ssl::context ssl_ctx_;
+    // Last TLS session established with the server, offered for resumption when a new connection is opened
+    SSL_SESSION *tls_session_;
+    // Requests waiting for a connection while the maximum number of active connections is in use
+    std::list<Waiter> waiters_;
+#elif defined(COM_SUPPORT_LIB_POCO)
+    // TLS context shared by all connections, built once
+    Poco::Net::Context::Ptr ssl_ctx_;
+    // Last TLS session established with the server, offered for resumption when a new connection is opened
+    Poco::Net::Session::Ptr tls_session_;
+    std::condition_variable released_;
+#endif
+
+    std::mutex mutex_;
+    std::list< std::unique_ptr<CtnApiConnection> > idle_;
+    unsigned int active_count_;
+
+    void purgeExpired(std::chrono::steady_clock::time_point now);
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    void openConnectionAsync(const RequestTimeouts &timeouts, AcquireHandler handler);
+    void releaseSlot();
+
+    static int storeNewTlsSession(SSL *ssl, SSL_SESSION *session);
+#elif defined(COM_SUPPORT_LIB_POCO)
+    std::unique_ptr<CtnApiConnection> openConnection();
+#endif
+
+public:
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    CtnApiConnectionPool(boost::asio::io_context &ioc, CtnApiResolver &resolver, std::string host, std::string port, bool secure, const ConnectionPoolOptions &options);
+#elif defined(COM_SUPPORT_LIB_POCO)
+    CtnApiConnectionPool(CtnApiResolver &resolver, std::string host, std::string port, bool secure, const ConnectionPoolOptions &options);
+#endif
+    ~CtnApiConnectionPool();
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    // Get a warm idle connection, or open a new one within the connect and TLS handshake timeouts. The handler is queued
+    //  while the maximum number of active connections is in use, and is always invoked from the I/O thread
+    void acquireAsync(const RequestTimeouts &timeouts, AcquireHandler handler);
+#elif defined(COM_SUPPORT_LIB_POCO)
+    // Get a warm idle connection, or open a new one. Blocks while the maximum number of active connections is in use, but
+    //  not past the deadline, in which case no connection is returned
+    std::unique_ptr<CtnApiConnection> acquire(std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
+#endif
+
+    // Return a connection to the pool. Connections that cannot be kept alive are closed
+    void release(std::unique_ptr<CtnApiConnection> connection, bool keep_alive);
+
+    TlsSessionStats tlsSessionStats();
+};
+
+}
+
+#endif // __CATENISAPICONNECTIONPOOL_H__
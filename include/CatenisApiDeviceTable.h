@@ -0,0 +1,44 @@
+//
+//  CatenisApiDeviceTable.h
+//  CatenisAPIClientCpp
+//
+#ifndef __CATENISAPIDEVICETABLE_H__
+#define __CATENISAPIDEVICETABLE_H__
+
+#include <string>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <CatenisApiClient.h>
+
+namespace ctn
+{
+
+/*
+ * Table of the devices referred to by the results of API method calls
+ *
+ * Results that refer to the same device (with the same ID, name and product unique ID) share a single device info
+ *  structure, so those devices can be compared by pointer. Devices are only kept in the table while they are referred
+ *  to by some result.
+ */
+class CtnApiDeviceTable
+{
+private:
+    std::mutex mutex_;
+    std::unordered_map< std::string, std::weak_ptr<DeviceInfo> > devices_;
+    // Table size at which entries of devices no longer referred to are removed
+    std::size_t purge_size_;
+
+    void purge();
+
+public:
+    CtnApiDeviceTable();
+
+    // Replace device with the shared device info of the same device, if any. Otherwise, it becomes the shared one
+    void intern(std::shared_ptr<DeviceInfo> &device);
+};
+
+}
+
+#endif // __CATENISAPIDEVICETABLE_H__
@@ -0,0 +1,50 @@
+//
+//  CatenisApiDigest.h
+//  CatenisAPIClientCpp
+//
+#ifndef __CATENISAPIDIGEST_H__
+#define __CATENISAPIDIGEST_H__
+
+#include <string>
+#include <cstddef>
+
+typedef struct evp_md_ctx_st EVP_MD_CTX;
+
+namespace ctn
+{
+
+// Length of hex encoded SHA-256 digest
+const std::size_t SHA256_HEX_LENGTH = 64;
+
+/*
+ * Incremental SHA-256 digest
+ *
+ * Data is fed in pieces, straight from where it is stored, so nothing needs to be concatenated before being hashed.
+ *  Copying a digest duplicates its current state, which allows the hash of a common prefix to be reused.
+ */
+class CtnApiSha256
+{
+private:
+    EVP_MD_CTX *ctx_;
+
+    CtnApiSha256 &operator=(const CtnApiSha256 &);
+
+public:
+    CtnApiSha256();
+    CtnApiSha256(const CtnApiSha256 &other);
+    ~CtnApiSha256();
+
+    CtnApiSha256 &update(const char *data, std::size_t size);
+    CtnApiSha256 &update(const std::string &data) { return update(data.data(), data.size()); }
+    CtnApiSha256 &update(char c) { return update(&c, 1); }
+
+    // Finish digest and write it, hex encoded, to out, which must have room for SHA256_HEX_LENGTH characters
+    void hexDigest(char *out);
+
+    // Finish digest and return it hex encoded
+    std::string hexDigest();
+};
+
+}
+
+#endif // __CATENISAPIDIGEST_H__
@@ -0,0 +1,77 @@
+//
+//  CatenisApiDiskCache.h
+//  CatenisAPIClientCpp
+//
+#ifndef __CATENISAPIDISKCACHE_H__
+#define __CATENISAPIDISKCACHE_H__
+
+#include <string>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+#include <CatenisApiClient.h>
+
+namespace ctn
+{
+
+/*
+ * Persistent cache of API method results, kept in a memory-mapped file
+ *
+ * Records are only ever appended to the file. They are found through a hash index, stored in the same file, whose
+ *  buckets hold the offset of the latest record of a chain of records linked from newest to oldest. Once the file
+ *  reaches its maximum size, no more records are added. The file is meant to be used by a single client at a time.
+ *  It is tied to the device and API server it was created for, and started over when it is opened for other ones.
+ */
+class CtnApiDiskCache
+{
+private:
+    std::string path_;
+    std::uint64_t max_size_;
+    std::uint64_t owner_hash_;
+
+#ifdef _WIN32
+    void *file_;
+    void *mapping_;
+#else
+    int fd_;
+#endif
+    char *base_;
+    std::uint64_t mapped_size_;
+
+    std::mutex mutex_;
+    unsigned long hits_;
+
+    void open();
+    void close();
+    bool map(std::uint64_t size);
+    void unmap();
+    void initialize();
+    bool isValid() const;
+    bool reserve(std::uint64_t size);
+
+    bool find(std::uint32_t kind, const std::string &key, const char *&value, std::uint32_t &value_size);
+    void append(std::uint32_t kind, const std::string &key, const std::string &value);
+
+    CtnApiDiskCache(const CtnApiDiskCache &) = delete;
+    CtnApiDiskCache &operator=(const CtnApiDiskCache &) = delete;
+
+public:
+    // Open (or create) the cache file, for the given owner (device and API server). Throws CatenisClientError if it
+    //  cannot be opened
+    CtnApiDiskCache(std::string path, std::uint64_t max_size, const std::string &owner);
+    ~CtnApiDiskCache();
+
+    bool load(const std::string &key, ReadMessageResult &data);
+    bool load(const std::string &key, RetrieveMessageContainerResult &data);
+
+    void save(const std::string &key, const ReadMessageResult &data);
+    void save(const std::string &key, const RetrieveMessageContainerResult &data);
+
+    // Number of results found in the file
+    unsigned long hits();
+};
+
+}
+
+#endif // __CATENISAPIDISKCACHE_H__
@@ -82,5 +82,23 @@ public:
     std::string getErrorDescription() override { return("Client error: " + errorMessage); }
 };
 
+/*
+ * Catenis Exceptions to be thrown when a request does not complete within the time allowed for it.
+ *
+ * @member phase : The phase of the request that timed out ["connect"|"TLS handshake"|"send"|"receive"|"deadline"].
+ */
+class CatenisTimeoutError : public CatenisClientError
+{
+public:
+    explicit CatenisTimeoutError(std::string phase_arg)
+            : CatenisClientError(phase_arg == "deadline" ? "Request deadline exceeded" : "Request timed out (" + phase_arg + ")"), phase(phase_arg) {}
+    ~CatenisTimeoutError() override = default;
+
+    std::string getPhase() { return(phase); }
+
+private:
+    std::string phase;
+};
+
 }
 #endif
@@ -0,0 +1,73 @@
+//
+//  CatenisApiExecutor.h
+//  CatenisAPIClientCpp
+//
+#ifndef __CATENISAPIEXECUTOR_H__
+#define __CATENISAPIEXECUTOR_H__
+
+#include <vector>
+#include <functional>
+#include <thread>
+#include <chrono>
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#elif defined(COM_SUPPORT_LIB_POCO)
+#include <deque>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace ctn
+{
+
+/*
+ * Run loop shared by all asynchronous requests of a client
+ *
+ * With the Boost Asio library, a single I/O thread runs an io_context that drives every in-flight request.
+ * With the Poco library, a fixed set of worker threads runs the (blocking) requests.
+ */
+class CtnApiExecutor
+{
+private:
+    std::vector<std::thread> threads_;
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    boost::asio::io_context ioc_;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work_;
+#elif defined(COM_SUPPORT_LIB_POCO)
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::deque< std::function<void()> > tasks_;
+    std::multimap<std::chrono::steady_clock::time_point, std::function<void()> > delayed_tasks_;
+    bool stopping_;
+#endif
+
+    void run();
+
+public:
+    explicit CtnApiExecutor(unsigned int num_threads);
+    ~CtnApiExecutor();
+
+    // Stop the run loop and wait for its threads to finish. Tasks not yet run are discarded
+    void stop();
+
+    // Schedule task to be run by the executor
+    void post(std::function<void()> task);
+
+    // Schedule task to be run by the executor once the delay has elapsed
+    void postAfter(std::chrono::milliseconds delay, std::function<void()> task);
+
+    // Indicates whether the calling thread is one of the executor's threads
+    bool runningInThisThread() const;
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    boost::asio::io_context &ioContext() { return ioc_; }
+#endif
+};
+
+}
+
+#endif // __CATENISAPIEXECUTOR_H__
@@ -18,8 +18,22 @@
 
 #include <map>
 #include <string>
+#include <memory>
+#include <functional>
+#include <future>
+#include <exception>
+#include <utility>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <random>
 
 #include <CatenisApiClient.h>
+#include <CatenisApiScheduler.h>
+#include <CatenisApiResultCache.h>
 
 // Internal constants
 const std::string API_PATH = "/api/";
@@ -28,27 +42,55 @@ const std::string SIGN_METHOD_ID = "CTN1-HMAC-SHA256";
 const std::string SCOPE_REQUEST = "ctn1_request";
 const std::string TIME_STAMP_HDR = "x-bcot-timestamp";
 const int SIGN_VALID_DAYS = 7;
-
-#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-#include <json-spirit/json_spirit_value.h>
-#elif defined(COM_SUPPORT_LIB_POCO)
-// Forward declare Poco JSON object
-namespace Poco
-{
-    namespace JSON
-    {
-        class Object;
-    }
-}
-#endif
+const unsigned int DEFAULT_BATCH_WINDOW = 8;
 
 namespace ctn
 {
 // Forward declaration of ApiErrorResponse structure
 struct ApiErrorResponse;
+class CtnApiConnectionPool;
+class CtnApiExecutor;
+class CtnApiResolver;
+class CtnApiDeviceTable;
+class CtnApiSigningKey;
+
+/*
+ * API method request structure
+ *
+ * @member verb : HTTP method ["GET"|"POST"]
+ * @member methodpath : Path of API method endpoint, relative to the API root, with ':name' placeholders for path parameters
+ * @member params : Path parameters by placeholder
+ * @member queries : Query string parameters
+ * @member payload : JSON request body (POST requests only)
+ * @member payloadHash : Hex encoded SHA-256 hash of payload, if already computed while the payload was assembled
+ * @member timeouts : Time allowed for the request. If not set, the timeouts in effect for the calling thread are used
+ * @member deadline : Point in time by which the request, including all its attempts, must complete. It is set from the
+ *  deadline timeout when the request is first issued (time_point::max(): no deadline)
+ * @member priority : Order in which the request is sent, if it has to wait for the request scheduler
+ */
+struct ApiRequest
+{
+    std::string verb;
+    std::string methodpath;
+    std::map<std::string, std::string> params;
+    std::map<std::string, std::string> queries;
+    std::string payload;
+    std::string payloadHash;
+    std::shared_ptr<const RequestTimeouts> timeouts;
+    std::chrono::steady_clock::time_point deadline;
+    RequestPriority priority;
+
+    ApiRequest(std::string verb_arg, std::string methodpath_arg)
+        : verb(std::move(verb_arg)), methodpath(std::move(methodpath_arg)), deadline(std::chrono::steady_clock::time_point::max()),
+          priority(verb == "GET" ? RequestPriority::read : RequestPriority::write) {}
+};
 
 class CtnApiInternals
 {
+public:
+    // Callback invoked when an asynchronous HTTP request completes
+    typedef std::function<void(std::exception_ptr error, std::string &response_data)> HttpCallback;
+
 private:
     std::string device_id_;
     std::string api_access_secret_;
@@ -60,32 +102,377 @@ private:
     std::string version_;
     
     std::string root_api_endpoint_;
-    time_t last_signdate_;
-    std::string last_signkey_;
+    // Current signing key. It is swapped atomically when it expires, so requests are signed without taking a lock
+    std::atomic<const CtnApiSigningKey *> signing_key_;
+    std::unique_ptr<const CtnApiSigningKey> current_signing_key_;
+    // The key replaced at the last rollover is kept alive, since other threads might still be signing with it
+    std::unique_ptr<const CtnApiSigningKey> previous_signing_key_;
+    std::mutex signkey_mutex_;
+
+    std::unique_ptr<CtnApiExecutor> executor_;
+    // Cached server addresses, shared by the connections of the pool
+    std::unique_ptr<CtnApiResolver> resolver_;
+    std::unique_ptr<CtnApiConnectionPool> connection_pool_;
+    std::unique_ptr<CtnApiScheduler> scheduler_;
+    // Caches of API method results. Not set if disabled
+    std::unique_ptr<CtnApiDiskCache> disk_cache_;
+    std::unique_ptr< CtnApiResultCache<ReadMessageResult> > message_cache_;
+    std::unique_ptr< CtnApiResultCache<RetrieveMessageContainerResult> > container_cache_;
+    // Devices shared by the results of API method calls. Not set if disabled
+    std::unique_ptr<CtnApiDeviceTable> device_table_;
+    std::shared_ptr<const RequestTimeouts> timeouts_;
+    unsigned int max_active_connections_;
+    bool streaming_json_parsing_;
+
+    RetryOptions retry_options_;
+    // Retries left in the budget
+    double retry_tokens_;
+    std::mt19937 retry_rng_;
+    std::mutex retry_mutex_;
+
+    // Callers waiting on GET requests in progress, by request key (see inflightRequestKey). The caller that issued the
+    //  request is not included
+    std::map<std::string, std::vector<HttpCallback>> inflight_requests_;
+    std::mutex inflight_mutex_;
+
+    /*
+     * State of an asynchronous request that can be retried
+     *
+     * @member attempt : Number of attempts made so far
+     * @member delay : Time waited before the last retry
+     */
+    struct RetryState
+    {
+        ApiRequest request;
+        HttpCallback callback;
+        unsigned int attempt;
+        std::chrono::milliseconds delay;
+
+        RetryState(ApiRequest request_arg, HttpCallback callback_arg)
+            : request(std::move(request_arg)), callback(callback_arg), attempt(0), delay(0) {}
+    };
+
+    /*
+     * State shared by the requests of a batch API method call
+     *
+     * @member makeRequest : Builds the request for the item with the given index
+     * @member parse : Method used to parse the response of each item
+     * @member timeouts : Time allowed for each item, as in effect for the thread that made the batch call
+     * @member results : Outcome of each item
+     * @member next : Index of the next item to be issued
+     * @member pending : Number of items not yet completed
+     * @member done : Fulfilled once all items have completed
+     */
+    template<typename Result>
+    struct BatchState
+    {
+        std::function<ApiRequest(std::size_t index)> makeRequest;
+        void (CtnApiInternals::*parse)(Result &, std::string);
+        std::shared_ptr<const RequestTimeouts> timeouts;
+        std::vector< BatchItemResult<Result> > *results;
+        std::mutex mutex;
+        std::size_t next;
+        std::size_t pending;
+        std::promise<void> done;
+    };
+
+    // Issue the next not yet issued item of a batch, if any
+    template<typename Result>
+    void issueBatchItem(std::shared_ptr< BatchState<Result> > state)
+    {
+        for (;;) {
+            std::size_t index;
+
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+
+                if (state->next >= state->results->size()) return;
+
+                index = state->next++;
+            }
+
+            try {
+                // Items after the first ones are issued from the executor's thread
+                ApiRequest request = state->makeRequest(index);
+                request.timeouts = state->timeouts;
+                request.priority = RequestPriority::bulk;
+
+                invokeApiMethodAsync<Result>(std::move(request), state->parse, [this, state, index](std::exception_ptr error, Result &data) {
+                    BatchItemResult<Result> &item = (*state->results)[index];
+
+                    item.error = error;
+                    if (!error) item.data = std::move(data);
+
+                    // Keep the window full
+                    this->issueBatchItem<Result>(state);
+
+                    completeBatchItem<Result>(*state);
+                });
+
+                return;
+            }
+            catch (...) {
+                // Request could not be issued. Record it and move on to the next item
+                (*state->results)[index].error = std::current_exception();
+                completeBatchItem<Result>(*state);
+            }
+        }
+    }
+
+    /*
+     * State shared by the requests of a time-sharded List Messages scan
+     *
+     * @member makeRequest : Builds the request for the time frame with the given boundaries (milliseconds since the Unix
+     *  epoch, inclusive)
+     * @member timeouts : Time allowed for each request, as in effect for the thread that made the scan
+     * @member maxInFlight : Maximum number of requests in progress at the same time
+     * @member frames : Time frames not yet requested
+     * @member inFlight : Number of requests in progress
+     * @member messages : Messages retrieved so far
+     * @member countExceeded : Indicates whether a time frame that could not be split any further held too many messages
+     * @member error : First error raised by a request. No more requests are issued after it
+     * @member done : Fulfilled once all requests have completed
+     */
+    struct MessageScanState
+    {
+        std::function<ApiRequest(long long start, long long end)> makeRequest;
+        std::shared_ptr<const RequestTimeouts> timeouts;
+        unsigned int maxInFlight;
+        std::mutex mutex;
+        std::deque< std::pair<long long, long long> > frames;
+        unsigned int inFlight;
+        std::vector< std::shared_ptr<MessageDescription> > messages;
+        bool countExceeded;
+        std::exception_ptr error;
+        std::promise<void> done;
+    };
+
+    void issueMessageScanFrames(std::shared_ptr<MessageScanState> state);
+    void completeMessageScanFrame(std::shared_ptr<MessageScanState> state, std::pair<long long, long long> frame, std::exception_ptr error, ListMessagesResult &result);
+
+    template<typename Result>
+    static void completeBatchItem(BatchState<Result> &state)
+    {
+        bool all_done;
+
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            all_done = --state.pending == 0;
+        }
+
+        if (all_done) state.done.set_value();
+    }
+
+    void checkBlockingCallAllowed();
+    std::shared_ptr<const RequestTimeouts> currentTimeouts() const;
+
+    void prepareRequest(ApiRequest &request, std::string &methodpath, std::map<std::string, std::string> &headers);
+    static std::string inflightRequestKey(const ApiRequest &request);
+    bool joinInflightRequest(const std::string &key, HttpCallback callback);
+    void completeInflightRequest(const std::string &key, std::exception_ptr error, const std::string &response_data);
+    void startHttpRequestAsync(ApiRequest request, HttpCallback callback);
+    bool isRetriable(const ApiRequest &request);
+    bool shouldRetry(std::exception_ptr error, unsigned int attempt);
+    std::chrono::milliseconds nextRetryDelay(std::chrono::milliseconds previous_delay);
+    void attemptHttpRequestAsync(std::shared_ptr<RetryState> state);
+    void sendHttpRequestAsync(ApiRequest request, HttpCallback callback);
+    void issueHttpRequestAsync(ApiRequest request, HttpCallback callback);
+    void completeHttpRequest(unsigned int status_code, const std::string &status_message, std::string &response_data, const HttpCallback &callback);
+#if defined(COM_SUPPORT_LIB_POCO)
+    void runHttpRequest(ApiRequest &request, std::string &response_data);
+    void sendHttpRequest(ApiRequest &request, std::string &response_data);
+    void issueHttpRequest(ApiRequest &request, std::string &response_data);
+    void performRequest(const std::string &verb, const std::string &methodpath, const std::map<std::string, std::string> &headers, const std::string &payload, const RequestTimeouts &timeouts, std::chrono::steady_clock::time_point deadline, unsigned int &status_code, std::string &status_message, std::string &response_data);
+#endif
     
-    void signRequest(std::string verb, std::string endpoint, std::map<std::string, std::string> &headers, std::string payload, time_t now);
-    std::string hashData(const std::string str);
-    std::string signData(const std::string key, const std::string data, bool hex_encode = false);
+    const CtnApiSigningKey &currentSigningKey(time_t now);
+    void signRequest(const std::string &verb, const std::string &endpoint, std::map<std::string, std::string> &headers, const std::string &payload_hash, time_t now);
 
     void parseApiErrorResponse(ApiErrorResponse &error_response, std::string &json_data);
+
+    // Have the devices referred to by the result shared through the device table
+    void internDevices(ReadMessageResult &data);
+    void internDevices(ListMessagesResult &data);
+    void internDevices(RetrievePermissionRightsResult &data);
     
 public:
     
-    CtnApiInternals(std::string device_id, std::string api_access_secret, std::string host, std::string port, std::string environment, bool secure, std::string version);
-#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-    void httpRequest(std::string verb, std::string methodpath, std::map<std::string, std::string> &params, std::map<std::string, std::string> &queries, json_spirit::mValue const &reqData, std::string &response_data);
-#elif defined(COM_SUPPORT_LIB_POCO)
-    void httpRequest(std::string verb, std::string methodpath, std::map<std::string, std::string> &params, std::map<std::string, std::string> &queries, Poco::JSON::Object &request_data, std::string &response_data);
-#endif
+    CtnApiInternals(std::string device_id, std::string api_access_secret, std::string host, std::string port, std::string environment, bool secure, std::string version, const ClientOptions &options);
+    ~CtnApiInternals();
+
+    void httpRequest(ApiRequest request, std::string &response_data);
+    void httpRequestAsync(ApiRequest request, HttpCallback callback);
+
+    TlsSessionStats tlsSessionStats();
+    SchedulerStats schedulerStats();
+    ResultCacheStats resultCacheStats();
+
+    CtnApiResultCache<ReadMessageResult> *messageCache() { return message_cache_.get(); }
+    CtnApiResultCache<RetrieveMessageContainerResult> *containerCache() { return container_cache_.get(); }
+
+    // Run task from the executor's thread
+    void post(std::function<void()> task);
+
+    // Issue API method request, wait for it to complete, and parse its response into data. The response is handed over
+    //  to the parse function, which takes it by value since it may keep it. It is parsed on the calling thread, so
+    //  threads sharing the client parse their responses concurrently, without holding up the executor's thread
+    template<typename Result>
+    void invokeApiMethod(ApiRequest request, void (CtnApiInternals::*parse)(Result &, std::string), Result &data)
+    {
+        std::string response_data;
+
+        httpRequest(std::move(request), response_data);
+        (this->*parse)(data, std::move(response_data));
+    }
+
+    // Issue API method request asynchronously, and parse its response into the result passed to the callback
+    template<typename Result>
+    void invokeApiMethodAsync(ApiRequest request, void (CtnApiInternals::*parse)(Result &, std::string), ApiCallback<Result> callback)
+    {
+        httpRequestAsync(std::move(request), [this, parse, callback](std::exception_ptr error, std::string &response_data) {
+            Result data;
+
+            if (!error) {
+                try {
+                    (this->*parse)(data, std::move(response_data));
+                }
+                catch (...) {
+                    error = std::current_exception();
+                }
+            }
+
+            callback(error, data);
+        });
+    }
+
+    template<typename Result>
+    std::future<Result> invokeApiMethodAsync(ApiRequest request, void (CtnApiInternals::*parse)(Result &, std::string))
+    {
+        std::shared_ptr< std::promise<Result> > promise(new std::promise<Result>());
+
+        invokeApiMethodAsync<Result>(std::move(request), parse, [promise](std::exception_ptr error, Result &data) {
+            if (error) promise->set_exception(error);
+            else promise->set_value(std::move(data));
+        });
+
+        return promise->get_future();
+    }
+
+    // Get the cached result of the API method, if any. Otherwise, issue its request and cache its result
+    template<typename Result>
+    void invokeCachedApiMethod(CtnApiResultCache<Result> *cache, const std::string &key, ApiRequest request, void (CtnApiInternals::*parse)(Result &, std::string), Result &data)
+    {
+        if (cache != nullptr && cache->find(key, data)) return;
+
+        invokeApiMethod<Result>(std::move(request), parse, data);
+
+        if (cache != nullptr) cache->store(key, data);
+    }
+
+    template<typename Result>
+    void invokeCachedApiMethodAsync(CtnApiResultCache<Result> *cache, const std::string &key, ApiRequest request, void (CtnApiInternals::*parse)(Result &, std::string), ApiCallback<Result> callback)
+    {
+        if (cache != nullptr) {
+            std::shared_ptr<Result> data(new Result());
+
+            if (cache->find(key, *data)) {
+                // Callback is still invoked from the executor's thread
+                return post([callback, data]() {
+                    callback(std::exception_ptr(), *data);
+                });
+            }
+
+            ApiCallback<Result> user_callback = callback;
+
+            callback = [cache, key, user_callback](std::exception_ptr error, Result &data) {
+                if (!error) cache->store(key, data);
+
+                user_callback(error, data);
+            };
+        }
+
+        invokeApiMethodAsync<Result>(std::move(request), parse, callback);
+    }
+
+    template<typename Result>
+    std::future<Result> invokeCachedApiMethodAsync(CtnApiResultCache<Result> *cache, const std::string &key, ApiRequest request, void (CtnApiInternals::*parse)(Result &, std::string))
+    {
+        std::shared_ptr< std::promise<Result> > promise(new std::promise<Result>());
+
+        if (cache != nullptr) {
+            Result data;
+
+            if (cache->find(key, data)) {
+                promise->set_value(std::move(data));
+                return promise->get_future();
+            }
+        }
+
+        invokeApiMethodAsync<Result>(std::move(request), parse, [promise, cache, key](std::exception_ptr error, Result &data) {
+            if (error) return promise->set_exception(error);
+
+            if (cache != nullptr) cache->store(key, data);
+
+            promise->set_value(std::move(data));
+        });
+
+        return promise->get_future();
+    }
+
+    // Issue count API method requests, keeping at most max_in_flight of them in progress at any time, and wait for all of
+    //  them to complete. Each request is only built (and signed) when it is about to be issued
+    template<typename Result>
+    void invokeApiMethodBatch(std::size_t count, unsigned int max_in_flight, std::function<ApiRequest(std::size_t index)> make_request,
+            void (CtnApiInternals::*parse)(Result &, std::string), std::vector< BatchItemResult<Result> > &results)
+    {
+        checkBlockingCallAllowed();
+
+        results.clear();
+        results.resize(count);
+
+        if (count == 0) return;
+
+        if (max_in_flight == 0) {
+            max_in_flight = this->max_active_connections_ > 0 ? this->max_active_connections_ : DEFAULT_BATCH_WINDOW;
+        }
+
+        std::shared_ptr< BatchState<Result> > state(new BatchState<Result>());
+
+        state->makeRequest = make_request;
+        state->parse = parse;
+        state->timeouts = currentTimeouts();
+        state->results = &results;
+        state->next = 0;
+        state->pending = count;
+
+        std::future<void> done = state->done.get_future();
+
+        for (std::size_t idx = std::min<std::size_t>(max_in_flight, count); idx > 0; idx--) {
+            issueBatchItem<Result>(state);
+        }
+
+        done.wait();
+    }
+
+    // Retrieve the messages of the time frame from start to end (milliseconds since the Unix epoch, inclusive), split
+    //  into shards that are retrieved concurrently. Shards that hold too many messages are split further. The messages
+    //  are returned in date order, without duplicates
+    void invokeMessageScan(long long start, long long end, unsigned int shards, std::function<ApiRequest(long long start, long long end)> make_request, ListMessagesResult &data);
+
 
     // Methods to parse the returned API Json string-messages.
     void parseLogMessage(LogMessageResult &user_return_data, std::string json_data);
     void parseSendMessage(SendMessageResult &user_return_data, std::string json_data);
     void parseReadMessage(ReadMessageResult &user_return_data, std::string json_data);
+    void parseReadMessageView(ReadMessageView &user_return_data, std::string json_data);
     void parseRetrieveMessageContainer(RetrieveMessageContainerResult &user_return_data, std::string json_data);
     void parseListMessages(ListMessagesResult &user_return_data, std::string json_data);
+    void parseListMessagesFlat(FlatListMessagesResult &user_return_data, std::string json_data);
+    void parseListMessagesArena(ArenaListMessagesResult &user_return_data, std::string json_data);
+    void parseListMessagesView(ListMessagesView &user_return_data, std::string json_data);
     void parseListPermissionEvents(ListPermissionEventsResult &user_return_data, std::string json_data);
     void parseRetrievePermissionRights(RetrievePermissionRightsResult &user_return_data, std::string json_data);
+    void parseRetrievePermissionRightsArena(ArenaRetrievePermissionRightsResult &user_return_data, std::string json_data);
     void parseSetPermissionRights(SetPermissionRightsResult &user_return_data, std::string json_data);
     void parseListNotificationEvents(ListNotificationEventsResult &user_return_data, std::string json_data);
     void parseCheckEffectivePermissionRight(CheckEffectivePermissionRightResult &user_return_data, std::string json_data);
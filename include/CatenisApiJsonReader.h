@@ -0,0 +1,90 @@
+//
+//  CatenisApiJsonReader.h
+//  CatenisAPIClientCpp
+//
+#ifndef __CATENISAPIJSONREADER_H__
+#define __CATENISAPIJSONREADER_H__
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace ctn
+{
+
+/*
+ * Forward-only (pull) JSON reader
+ *
+ * Values are read one at a time, straight from the JSON text, in the order in which they appear. No document tree is
+ *  built, so callers can copy the values they are interested in directly into their own structures, and skip the
+ *  others. Any syntax error, or any value that is not of the requested type, raises a ctn::CatenisClientError
+ */
+class CtnApiJsonReader
+{
+public:
+    enum ValueType
+    {
+        NullValue,
+        BoolValue,
+        NumberValue,
+        StringValue,
+        ObjectValue,
+        ArrayValue
+    };
+
+private:
+    const char *pos_;
+    const char *end_;
+    // Whether a value has already been read from each object/array being read, innermost last
+    std::vector<bool> has_values_;
+
+    void skipWhitespace();
+    char nextChar();
+    void expect(char c);
+    void expectLiteral(const char *literal);
+    bool nextItem(char closing);
+    void readStringContent(std::string &value);
+    void readUnicodeEscape(std::string &value);
+    unsigned int readHex4();
+    void skipNumber();
+
+public:
+    CtnApiJsonReader(const char *data, std::size_t size);
+    explicit CtnApiJsonReader(const std::string &json) : CtnApiJsonReader(json.data(), json.size()) {}
+
+    // Type of the value about to be read
+    ValueType peek();
+
+    // Start reading an object. Its members are then read by calling nextMember() until it returns false
+    void beginObject();
+    // Read name of the next object member, leaving the reader positioned at its value. Returns false (and ends
+    //  reading the object) if there are no more members
+    bool nextMember(std::string &name);
+
+    // Start reading an array. Its elements are then read by calling nextElement() until it returns false
+    void beginArray();
+    // Position reader at next array element. Returns false (and ends reading the array) if there are no more elements
+    bool nextElement();
+
+    void readString(std::string &value);
+    std::string readString();
+    // Read a string value without unescaping it. The raw text of the string (between the quotes) is left in place, in
+    //  the JSON text. escaped is set if it contains escape sequences
+    void readRawString(const char *&data, std::size_t &size, bool &escaped);
+    bool readBool();
+    int readInt();
+    void readNull();
+
+    // Skip the next value, whatever its type
+    void skipValue();
+
+    // Make sure that nothing but whitespace follows the value that has been read
+    void end();
+
+    // Unescape the raw text of a string value, as returned by readRawString()
+    static std::string unescape(const char *data, std::size_t size);
+};
+
+}
+
+#endif // __CATENISAPIJSONREADER_H__
@@ -0,0 +1,58 @@
+//
+//  CatenisApiJsonWriter.h
+//  CatenisAPIClientCpp
+//
+#ifndef __CATENISAPIJSONWRITER_H__
+#define __CATENISAPIJSONWRITER_H__
+
+#include <string>
+#include <cstddef>
+
+namespace ctn
+{
+
+/*
+ * Forward-only JSON writer
+ *
+ * Values are appended straight to the text being produced, in the order in which they are written, so a request
+ *  body can be serialized without first building a JSON document tree. The writer does not allocate memory itself:
+ *  reserving room in the output string beforehand (see quotedSize()) makes serializing a request body take a single
+ *  allocation.
+ *
+ * Strings are escaped as required by JSON; non-ASCII (UTF-8) characters are written as they are.
+ */
+class CtnApiJsonWriter
+{
+private:
+    std::string &out_;
+    unsigned int depth_;
+    // One bit per nesting level: whether a value has already been written to the object/array at that level, and
+    //  whether that level is an array
+    unsigned long long has_values_;
+    unsigned long long arrays_;
+
+    void beginValue();
+    void beginContainer(char opening, bool is_array);
+    void endContainer(char closing);
+
+public:
+    explicit CtnApiJsonWriter(std::string &out) : out_(out), depth_(0), has_values_(0), arrays_(0) {}
+
+    CtnApiJsonWriter &beginObject() { beginContainer('{', false); return *this; }
+    CtnApiJsonWriter &endObject() { endContainer('}'); return *this; }
+    CtnApiJsonWriter &beginArray() { beginContainer('[', true); return *this; }
+    CtnApiJsonWriter &endArray() { endContainer(']'); return *this; }
+
+    // Write name of object member, to be followed by its value. The name is not escaped
+    CtnApiJsonWriter &member(const char *name);
+
+    CtnApiJsonWriter &value(const std::string &value);
+    CtnApiJsonWriter &value(bool value);
+
+    // Number of characters that the given string takes once written (quoted and escaped)
+    static std::size_t quotedSize(const std::string &value);
+};
+
+}
+
+#endif // __CATENISAPIJSONWRITER_H__
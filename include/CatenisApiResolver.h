@@ -0,0 +1,101 @@
+//
+//  CatenisApiResolver.h
+//  CatenisAPIClientCpp
+//
+#ifndef __CATENISAPIRESOLVER_H__
+#define __CATENISAPIRESOLVER_H__
+
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <functional>
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+#include <boost/asio/ip/tcp.hpp>
+#elif defined(COM_SUPPORT_LIB_POCO)
+#include <Poco/Net/SocketAddress.h>
+#endif
+
+namespace ctn
+{
+
+class CtnApiExecutor;
+
+/*
+ * Cache of resolved server addresses
+ *
+ * Addresses are looked up once per host and port, and then reused for the configured time to live. Once that time
+ *  elapses, the cached addresses are still used while they are looked up again in the background, so opening a
+ *  connection only waits on DNS the very first time. Each lookup returns the addresses rotated by one position, so
+ *  connections are spread across all of them (with Boost Asio, the remaining addresses are tried if the first one fails).
+ */
+class CtnApiResolver
+{
+public:
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    typedef boost::asio::ip::tcp::endpoint Endpoint;
+    typedef std::function<void(const boost::system::error_code &ec, std::vector<Endpoint> endpoints)> ResolveHandler;
+#elif defined(COM_SUPPORT_LIB_POCO)
+    typedef Poco::Net::SocketAddress Endpoint;
+#endif
+
+private:
+    /*
+     * Cached addresses of a host and port
+     *
+     * @member resolvedAt : Time when the addresses were (last) looked up
+     * @member next : Index of the address to be returned first by the next lookup
+     * @member resolving : Indicates whether the addresses are being looked up
+     * @member waiters : Lookups waiting for the addresses to be resolved for the first time
+     */
+    struct Entry
+    {
+        std::vector<Endpoint> endpoints;
+        std::chrono::steady_clock::time_point resolvedAt;
+        std::size_t next;
+        bool resolving;
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+        std::list<ResolveHandler> waiters;
+#endif
+
+        Entry() : next(0), resolving(false) {}
+
+        std::vector<Endpoint> rotatedEndpoints();
+    };
+
+    CtnApiExecutor &executor_;
+    std::chrono::seconds ttl_;
+    std::mutex mutex_;
+    // Entries by "host:port"
+    std::map<std::string, Entry> entries_;
+
+    bool isCached(const Entry &entry) const;
+    bool needsRefresh(const Entry &entry, std::chrono::steady_clock::time_point now) const;
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    void startLookup(const std::string &key, const std::string &host, const std::string &port);
+#elif defined(COM_SUPPORT_LIB_POCO)
+    static std::vector<Endpoint> lookup(const std::string &host, const std::string &port);
+    void storeEndpoints(const std::string &key, std::vector<Endpoint> endpoints);
+    void refresh(const std::string &key, const std::string &host, const std::string &port);
+#endif
+
+public:
+    // A time to live of 0 disables the cache: addresses are then looked up every time
+    CtnApiResolver(CtnApiExecutor &executor, unsigned int ttl);
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    // Get addresses of host. The handler is invoked right away if they are cached, or from the I/O thread otherwise
+    void resolveAsync(const std::string &host, const std::string &port, ResolveHandler handler);
+#elif defined(COM_SUPPORT_LIB_POCO)
+    // Get addresses of host. Only blocks if they are not cached
+    std::vector<Endpoint> resolve(const std::string &host, const std::string &port);
+#endif
+};
+
+}
+
+#endif // __CATENISAPIRESOLVER_H__
@@ -0,0 +1,173 @@
+//
+//  CatenisApiResultCache.h
+//  CatenisAPIClientCpp
+//
+#ifndef __CATENISAPIRESULTCACHE_H__
+#define __CATENISAPIRESULTCACHE_H__
+
+#include <string>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <unordered_map>
+
+#include <CatenisApiClient.h>
+#include <CatenisApiDiskCache.h>
+#include <CatenisApiDeviceTable.h>
+
+namespace ctn
+{
+
+// Copies of cached results do not share the structures they point to, so changes made to a returned result do not
+//  affect the cached one. The exception are device info structures shared through a device table, which are read-only
+
+inline ReadMessageResult copyResult(const ReadMessageResult &result, CtnApiDeviceTable *device_table)
+{
+    ReadMessageResult copy(result);
+
+    if (device_table != nullptr) device_table->intern(copy.from);
+    else if (copy.from) copy.from = std::make_shared<DeviceInfo>(*copy.from);
+
+    return copy;
+}
+
+inline RetrieveMessageContainerResult copyResult(const RetrieveMessageContainerResult &result, CtnApiDeviceTable *)
+{
+    RetrieveMessageContainerResult copy(result);
+
+    if (copy.externalStorage) copy.externalStorage = std::make_shared<StorageProviderDictionary>(*copy.externalStorage);
+
+    return copy;
+}
+
+// Have the devices of a result share the device info structures of the device table, if any
+
+inline void internResult(ReadMessageResult &result, CtnApiDeviceTable *device_table)
+{
+    if (device_table != nullptr) device_table->intern(result.from);
+}
+
+inline void internResult(RetrieveMessageContainerResult &, CtnApiDeviceTable *)
+{
+}
+
+// Whether a result is final, and can thus be cached. A message container is only final once its blockchain
+//  transaction is confirmed, so unconfirmed containers are retrieved again every time
+
+inline bool isFinalResult(const ReadMessageResult &)
+{
+    return true;
+}
+
+inline bool isFinalResult(const RetrieveMessageContainerResult &result)
+{
+    return result.blockchain.isConfirmed;
+}
+
+/*
+ * Size-bounded cache of API method results, discarding the least recently used ones first
+ *
+ * Results can also be kept in a persistent cache, which is looked up when a result is not found in memory. When a
+ *  device table is given, the devices of the results share its device info structures, whether they are found in
+ *  memory or in the persistent cache
+ */
+template<typename Result>
+class CtnApiResultCache
+{
+private:
+    typedef std::list< std::pair<std::string, Result> > EntryList;
+
+    std::size_t capacity_;
+    CtnApiDiskCache *disk_cache_;
+    CtnApiDeviceTable *device_table_;
+    std::mutex mutex_;
+    // Most recently used entries first
+    EntryList entries_;
+    std::unordered_map<std::string, typename EntryList::iterator> index_;
+    unsigned long hits_;
+    unsigned long misses_;
+
+public:
+    CtnApiResultCache(std::size_t capacity, CtnApiDiskCache *disk_cache = nullptr, CtnApiDeviceTable *device_table = nullptr)
+        : capacity_(capacity), disk_cache_(disk_cache), device_table_(device_table), hits_(0), misses_(0) {}
+
+    // Get a copy of the cached result, if any
+    bool find(const std::string &key, Result &data)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = index_.find(key);
+
+            if (it != index_.end()) {
+                entries_.splice(entries_.begin(), entries_, it->second);
+                hits_++;
+
+                data = copyResult(it->second->second, device_table_);
+
+                return true;
+            }
+        }
+
+        bool found = disk_cache_ != nullptr && disk_cache_->load(key, data);
+
+        if (found) {
+            internResult(data, device_table_);
+            remember(key, data);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (found) hits_++;
+        else misses_++;
+
+        return found;
+    }
+
+    // Cache a copy of the result, if it is final
+    void store(const std::string &key, const Result &data)
+    {
+        if (!isFinalResult(data)) return;
+
+        if (disk_cache_ != nullptr) disk_cache_->save(key, data);
+
+        remember(key, data);
+    }
+
+    void counters(unsigned long &hits, unsigned long &misses)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        hits = hits_;
+        misses = misses_;
+    }
+
+private:
+    // Keep a copy of the result in memory
+    void remember(const std::string &key, const Result &data)
+    {
+        if (capacity_ == 0) return;
+
+        Result copy = copyResult(data, device_table_);
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(key);
+
+        if (it != index_.end()) {
+            it->second->second = std::move(copy);
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return;
+        }
+
+        entries_.emplace_front(key, std::move(copy));
+        index_[key] = entries_.begin();
+
+        if (entries_.size() > capacity_) {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+    }
+};
+
+}
+
+#endif // __CATENISAPIRESULTCACHE_H__
@@ -0,0 +1,106 @@
+//
+//  CatenisApiScheduler.h
+//  CatenisAPIClientCpp
+//
+#ifndef __CATENISAPISCHEDULER_H__
+#define __CATENISAPISCHEDULER_H__
+
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <functional>
+
+#include <CatenisApiClient.h>
+
+namespace ctn
+{
+
+class CtnApiExecutor;
+
+// Order in which queued requests are sent
+enum class RequestPriority
+{
+    read,
+    write,
+    bulk
+};
+
+/*
+ * Client-side limiter of the requests sent to the Catenis API server
+ *
+ * Requests are admitted while a token is available and the number of requests in progress is below the concurrency
+ *  limit. Tokens are added at the configured rate, up to the burst size. Requests that cannot be admitted right away
+ *  are queued by priority, and admitted as tokens are added and requests complete. Queued requests whose deadline
+ *  passes are dropped from the queue instead of being admitted late.
+ */
+class CtnApiScheduler
+{
+public:
+    typedef std::function<void()> Task;
+
+private:
+    static const std::size_t NUM_PRIORITIES = 3;
+
+    /*
+     * Request waiting to be admitted
+     *
+     * @member task : Task run once the request is admitted
+     * @member expire : Task run instead if the deadline passes while the request is queued
+     * @member deadline : Point in time by which the request must be admitted (time_point::max(): none)
+     */
+    struct QueuedRequest
+    {
+        Task task;
+        Task expire;
+        std::chrono::steady_clock::time_point deadline;
+
+        QueuedRequest(Task task_arg, Task expire_arg, std::chrono::steady_clock::time_point deadline_arg)
+            : task(task_arg), expire(expire_arg), deadline(deadline_arg) {}
+    };
+
+    CtnApiExecutor &executor_;
+    SchedulerOptions options_;
+    double burst_;
+
+    std::mutex mutex_;
+    std::deque<QueuedRequest> queues_[NUM_PRIORITIES];
+    double tokens_;
+    std::chrono::steady_clock::time_point last_refill_;
+    unsigned long in_flight_;
+    // Indicates whether a wake up is scheduled for when the next token is added
+    bool wakeup_pending_;
+    unsigned long peak_queue_depth_;
+    unsigned long queued_requests_;
+
+    std::size_t queueDepth() const;
+    void refill(std::chrono::steady_clock::time_point now);
+    void dropExpired(std::chrono::steady_clock::time_point now, std::vector<Task> &expired);
+    void dispatch(std::vector<Task> &ready);
+    void scheduleWakeup();
+    void scheduleExpiry(std::chrono::steady_clock::time_point deadline);
+    void admitQueued(std::unique_lock<std::mutex> &lock);
+
+public:
+    CtnApiScheduler(CtnApiExecutor &executor, const SchedulerOptions &options);
+
+    // Indicates whether any limit is set. If not, requests need not go through the scheduler
+    bool enabled() const;
+
+    // Run task once the request is admitted. The task might be run right away, from the calling thread. If the request
+    //  is still queued when its deadline passes, expire is run instead
+    void schedule(RequestPriority priority, Task task, std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max(),
+            Task expire = Task());
+
+    // Wait for the request to be admitted. Returns false if its deadline passes first
+    bool acquire(RequestPriority priority, std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
+
+    // Report that an admitted request has completed
+    void release();
+
+    SchedulerStats stats();
+};
+
+}
+
+#endif // __CATENISAPISCHEDULER_H__
@@ -0,0 +1,64 @@
+//
+//  CatenisApiSigningKey.h
+//  CatenisAPIClientCpp
+//
+#ifndef __CATENISAPISIGNINGKEY_H__
+#define __CATENISAPISIGNINGKEY_H__
+
+#include <string>
+#include <ctime>
+
+#include <openssl/opensslv.h>
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+typedef struct evp_mac_ctx_st EVP_MAC_CTX;
+#else
+typedef struct hmac_ctx_st HMAC_CTX;
+#endif
+
+namespace ctn
+{
+
+/*
+ * Key used to sign API requests, derived from the device's API access secret for a given sign date
+ *
+ * The HMAC context is keyed once, when the signing key is derived. Signing a request then only takes copying that
+ *  context and running it over the string to sign. Instances are immutable, so they can be shared by threads.
+ */
+class CtnApiSigningKey
+{
+private:
+    time_t date_;
+    std::string signdate_;
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    EVP_MAC_CTX *hmac_ctx_;
+#else
+    HMAC_CTX *hmac_ctx_;
+#endif
+
+    CtnApiSigningKey(const CtnApiSigningKey &);
+    CtnApiSigningKey &operator=(const CtnApiSigningKey &);
+
+    void freeContext();
+
+public:
+    CtnApiSigningKey(const std::string &api_access_secret, time_t date);
+    ~CtnApiSigningKey();
+
+    // Time when the key was derived
+    time_t date() const { return date_; }
+
+    // Sign date (YYYYMMDD) that is part of the credential scope
+    const std::string &signDate() const { return signdate_; }
+
+    // Indicates whether the key can still be used to sign a request issued at the given time
+    bool isValidAt(time_t now) const;
+
+    // HMAC-SHA256 of data, hex encoded
+    std::string sign(const std::string &data) const;
+};
+
+}
+
+#endif // __CATENISAPISIGNINGKEY_H__
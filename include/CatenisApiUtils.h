@@ -0,0 +1,36 @@
+//
+//  CatenisApiUtils.h
+//  CatenisAPIClientCpp
+//
+#ifndef __CATENISAPIUTILS_H__
+#define __CATENISAPIUTILS_H__
+
+#include <string>
+#include <cstddef>
+
+namespace ctn
+{
+
+/*
+ * Hex encode binary data (lower case, no terminating null character)
+ *
+ * @param[in] data : The data to encode
+ * @param[in] size : Number of bytes of data to encode
+ * @param[out] out : Buffer that receives the encoded data. It must have room for (2 * size) characters
+ */
+void hexEncode(const unsigned char *data, std::size_t size, char *out);
+
+/*
+ * Hex encode binary data (lower case)
+ *
+ * Can be used, for instance, to prepare a message to be logged or sent with the "hex" encoding
+ *
+ * @param[in] data : The data to encode
+ *
+ * @return The encoded data
+ */
+std::string hexEncode(const std::string &data);
+
+}
+
+#endif // __CATENISAPIUTILS_H__
@@ -0,0 +1,66 @@
+//
+//  CatenisApiArena.cpp
+//  CatenisAPIClientCpp
+//
+
+#include <algorithm>
+#include <utility>
+
+#include <CatenisApiArena.h>
+
+// Constructor
+ctn::ResultArena::ResultArena(std::size_t block_size) : block_size_(block_size), current_block_(0), offset_(0) {}
+
+void *ctn::ResultArena::allocate(std::size_t size, std::size_t alignment)
+{
+    if (current_block_ < blocks_.size()) {
+        Block &block = blocks_[current_block_];
+        std::size_t start = (offset_ + alignment - 1) & ~(alignment - 1);
+
+        if (start + size <= block.size) {
+            offset_ = start + size;
+            return block.data.get() + start;
+        }
+
+        // Move on to a block kept from before the arena was reset that is large enough, if any
+        for (std::size_t idx = current_block_ + 1; idx < blocks_.size(); idx++) {
+            if (size + alignment <= blocks_[idx].size) {
+                std::swap(blocks_[current_block_ + 1], blocks_[idx]);
+                current_block_++;
+                offset_ = 0;
+
+                return allocate(size, alignment);
+            }
+        }
+
+        current_block_++;
+    }
+
+    // Add a new block. Blocks are allocated with new[], so their start is suitably aligned for any type
+    Block block;
+
+    block.size = std::max(block_size_, size + alignment);
+    block.data.reset(new char[block.size]);
+
+    blocks_.insert(blocks_.begin() + current_block_, std::move(block));
+    offset_ = 0;
+
+    return allocate(size, alignment);
+}
+
+void ctn::ResultArena::reset()
+{
+    current_block_ = 0;
+    offset_ = 0;
+}
+
+std::size_t ctn::ResultArena::capacity() const
+{
+    std::size_t total = 0;
+
+    for (auto const &block : blocks_) {
+        total += block.size;
+    }
+
+    return total;
+}
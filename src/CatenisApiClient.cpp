@@ -9,583 +9,779 @@
 #include <iostream>
 #include <string>
 #include <map>
-
-#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-#include <json-spirit/json_spirit_value.h>
-#elif defined(COM_SUPPORT_LIB_POCO)
-#include <Poco/JSON/Object.h>
-#endif
+#include <future>
+#include <utility>
+#include <vector>
+#include <list>
+#include <chrono>
+#include <cstdio>
 
 #include <CatenisApiException.h>
 #include <CatenisApiInternals.h>
+#include <CatenisApiDigest.h>
+#include <CatenisApiJsonWriter.h>
+#include <CatenisApiJsonReader.h>
 #include <CatenisApiClient.h>
 
 
-// API Method: Log Message
-void ctn::CtnApiClient::logMessage(LogMessageResult &data, std::string message, const MessageOptions &option)
+// Request preparation shared by the synchronous and asynchronous variants of the API methods
+
+// Room taken by the member names, punctuation and boolean values of request bodies, and of each device structure
+//  (including the name of the member it is assigned to), on top of the size of their string values
+static const std::size_t JSON_OVERHEAD = 128;
+static const std::size_t DEVICE_JSON_OVERHEAD = 64;
+
+static void prepareLogMessage(ctn::ApiRequest &request, const std::string &message, const ctn::MessageOptions &option)
 {
-    std::map<std::string, std::string> params;
-    std::map<std::string, std::string> queries;
+    using ctn::CtnApiJsonWriter;
 
     // write request body
-#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-    json_spirit::mObject objData;
+    request.payload.clear();
+    request.payload.reserve(CtnApiJsonWriter::quotedSize(message) + CtnApiJsonWriter::quotedSize(option.encoding)
+            + CtnApiJsonWriter::quotedSize(option.storage) + JSON_OVERHEAD);
+
+    CtnApiJsonWriter(request.payload)
+        .beginObject()
+            .member("message").value(message)
+            .member("options").beginObject()
+                .member("encoding").value(option.encoding)
+                .member("encrypt").value(option.encrypt)
+                .member("storage").value(option.storage)
+            .endObject()
+        .endObject();
+}
+
+// Serialize the parts of a Send Message request body that do not depend on the target device. The returned string is
+//  left open (without its closing brace) so that the target device can be appended to it, for which extra_size bytes
+//  are reserved
+static std::string prepareSendMessageCommon(const std::string &message, const ctn::MessageOptions &option, std::size_t extra_size = 0)
+{
+    using ctn::CtnApiJsonWriter;
+
+    std::string common_data;
+    common_data.reserve(CtnApiJsonWriter::quotedSize(message) + CtnApiJsonWriter::quotedSize(option.encoding)
+            + CtnApiJsonWriter::quotedSize(option.storage) + JSON_OVERHEAD + extra_size);
+
+    CtnApiJsonWriter(common_data)
+        .beginObject()
+            .member("message").value(message)
+            .member("options").beginObject()
+                .member("encoding").value(option.encoding)
+                .member("encrypt").value(option.encrypt)
+                .member("readConfirmation").value(option.readConfirmation)
+                .member("storage").value(option.storage)
+            .endObject();
+
+    return common_data;
+}
+
+// Append the target device to the common data already in the request body, closing it
+static void appendTargetDevice(ctn::ApiRequest &request, const ctn::Device &device)
+{
+    using ctn::CtnApiJsonWriter;
 
-    objData["message"] = message;
+    request.payload += ",\"targetDevice\":";
 
-    json_spirit::mObject objOptions;
+    CtnApiJsonWriter(request.payload)
+        .beginObject()
+            .member("id").value(device.id)
+            .member("isProdUniqueId").value(device.isProdUniqueId)
+        .endObject();
 
-    objOptions["encoding"] = option.encoding;
-    objOptions["encrypt"] = option.encrypt;
-    objOptions["storage"] = option.storage;
+    request.payload += '}';
+}
 
-    objData["options"] = objOptions;
+static void prepareSendMessage(ctn::ApiRequest &request, const ctn::Device &device, const std::string &common_data, const ctn::CtnApiSha256 *common_data_hash = nullptr)
+{
+    using ctn::CtnApiJsonWriter;
+
+    // write request body. Target device comes last, as it would with the keys sorted
+    request.payload.reserve(common_data.size() + CtnApiJsonWriter::quotedSize(device.id) + DEVICE_JSON_OVERHEAD);
+    request.payload.assign(common_data);
+    appendTargetDevice(request, device);
+
+    if (common_data_hash != nullptr) {
+        // Only the part that follows the (already hashed) common data is left to be hashed
+        request.payloadHash = ctn::CtnApiSha256(*common_data_hash)
+                .update(request.payload.data() + common_data.size(), request.payload.size() - common_data.size())
+                .hexDigest();
+    }
+}
 
-    json_spirit::mValue request_data(objData);
-#elif defined(COM_SUPPORT_LIB_POCO)
-    Poco::JSON::Object request_data;
+static void prepareSendMessage(ctn::ApiRequest &request, const ctn::Device &device, const std::string &message, const ctn::MessageOptions &option)
+{
+    // Common data is built right into the request body, since it is not shared with other requests
+    request.payload = prepareSendMessageCommon(message, option, ctn::CtnApiJsonWriter::quotedSize(device.id) + DEVICE_JSON_OVERHEAD);
+    appendTargetDevice(request, device);
+}
 
-    request_data.set("message", message);
+static void prepareReadMessage(ctn::ApiRequest &request, const std::string &message_id, const std::string &encoding)
+{
+    request.params[":messageId"] = message_id;
+    request.queries["encoding"] = encoding;
+}
 
-    Poco::JSON::Object options;
-    options.set("encoding", option.encoding);
-    options.set("encrypt", option.encrypt);
-    options.set("storage", option.storage);
-    request_data.set("options", options);
-#endif
+// Messages are cached by ID and encoding, since their contents are returned in the requested encoding
+static std::string readMessageCacheKey(const std::string &message_id, const std::string &encoding)
+{
+    return message_id + ":" + encoding;
+}
 
-    std::string http_return_data;
-    this->internals_->httpRequest("POST", "messages/log", params, queries, request_data, http_return_data);
-    this->internals_->parseLogMessage(data, http_return_data);
+static void prepareRetrieveMessageContainer(ctn::ApiRequest &request, const std::string &message_id)
+{
+    request.params[":messageId"] = message_id;
 }
 
-// API Method: Send Message
-void ctn::CtnApiClient::sendMessage(SendMessageResult &data, const Device &device, std::string message, const MessageOptions&option)
+static void prepareListMessages(ctn::ApiRequest &request, const std::string &action, const std::string &direction, const std::string &from_device_ids, const std::string &to_device_ids, const std::string &from_device_prod_ids, const std::string &to_device_prod_ids, const std::string &read_state, const std::string &start_date, const std::string &endDate)
 {
-    std::map<std::string, std::string> params;
-    std::map<std::string, std::string> queries;
+    std::map<std::string, std::string> &queries = request.queries;
 
-    // write request body
-#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-    json_spirit::mObject objData;
+    queries["action"] = action;
+    queries["direction"] = direction;
+    
+    if(!from_device_ids.empty()) queries["fromDeviceIds"] = from_device_ids;
+    if(!to_device_ids.empty()) queries["toDeviceIds"] = to_device_ids;
+    if(!from_device_prod_ids.empty()) queries["fromDeviceProdUniqueIds"] = from_device_prod_ids;
+    if(!to_device_prod_ids.empty()) queries["toDeviceProdUniqueIds"] = to_device_prod_ids;
+    
+    queries["readState"] = read_state;
+    
+    if(!start_date.empty()) queries["startDate"] = start_date;
+    if(!endDate.empty()) queries["endDate"] = endDate;
+}
+
+// Date conversion used to split the time frame of List Messages requests
+
+// Number of days from the Unix epoch to the given (proleptic Gregorian) date
+static long long daysFromCivil(long long year, unsigned int month, unsigned int day)
+{
+    year -= month <= 2 ? 1 : 0;
+
+    long long era = (year >= 0 ? year : year - 399) / 400;
+    unsigned int year_of_era = static_cast<unsigned int>(year - era * 400);
+    unsigned int day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    unsigned int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+
+    return era * 146097 + static_cast<long long>(day_of_era) - 719468;
+}
+
+static void civilFromDays(long long days, long long &year, unsigned int &month, unsigned int &day)
+{
+    days += 719468;
+
+    long long era = (days >= 0 ? days : days - 146096) / 146097;
+    unsigned int day_of_era = static_cast<unsigned int>(days - era * 146097);
+    unsigned int year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    unsigned int day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    unsigned int mp = (5 * day_of_year + 2) / 153;
+
+    day = day_of_year - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<long long>(year_of_era) + era * 400 + (month <= 2 ? 1 : 0);
+}
+
+// Read a fixed number of decimal digits
+static bool readDigits(const std::string &str, std::size_t &pos, std::size_t count, unsigned int &value)
+{
+    if (pos + count > str.size()) return false;
+
+    value = 0;
+
+    for (std::size_t idx = 0; idx < count; idx++, pos++) {
+        if (str[pos] < '0' || str[pos] > '9') return false;
+
+        value = value * 10 + (str[pos] - '0');
+    }
+
+    return true;
+}
+
+// Parse an ISO 8601 formatted date and time (YYYY-MM-DD[THH:MM[:SS[.sss]]][Z|+HH:MM|-HH:MM]) into milliseconds since
+//  the Unix epoch
+static long long parseIsoDate(const std::string &date)
+{
+    std::size_t pos = 0;
+    unsigned int year, month, day, hour = 0, minute = 0, second = 0, millisecond = 0;
+    bool valid = readDigits(date, pos, 4, year) && pos < date.size() && date[pos++] == '-'
+            && readDigits(date, pos, 2, month) && pos < date.size() && date[pos++] == '-'
+            && readDigits(date, pos, 2, day) && month >= 1 && month <= 12 && day >= 1 && day <= 31;
+    long long offset = 0;
+
+    if (valid && pos < date.size() && (date[pos] == 'T' || date[pos] == ' ')) {
+        pos++;
+        valid = readDigits(date, pos, 2, hour) && pos < date.size() && date[pos++] == ':' && readDigits(date, pos, 2, minute);
+
+        if (valid && pos < date.size() && date[pos] == ':') {
+            pos++;
+            valid = readDigits(date, pos, 2, second);
+
+            if (valid && pos < date.size() && (date[pos] == '.' || date[pos] == ',')) {
+                unsigned int digit;
+                unsigned int scale = 100;
+
+                pos++;
+                valid = pos < date.size() && date[pos] >= '0' && date[pos] <= '9';
+
+                // Digits beyond milliseconds are ignored
+                while (valid && pos < date.size() && readDigits(date, pos, 1, digit)) {
+                    millisecond += digit * scale;
+                    scale /= 10;
+                }
+            }
+        }
+    }
+
+    if (valid && pos < date.size()) {
+        if (date[pos] == 'Z') {
+            pos++;
+        }
+        else if (date[pos] == '+' || date[pos] == '-') {
+            int sign = date[pos++] == '+' ? 1 : -1;
+            unsigned int offset_hour, offset_minute = 0;
+
+            valid = readDigits(date, pos, 2, offset_hour);
+
+            if (valid && pos < date.size()) {
+                if (date[pos] == ':') pos++;
+
+                valid = readDigits(date, pos, 2, offset_minute);
+            }
+
+            offset = sign * (static_cast<long long>(offset_hour) * 60 + offset_minute) * 60000;
+        }
+
+        valid = valid && pos == date.size();
+    }
+
+    if (!valid) {
+        throw ctn::CatenisClientError("Invalid ISO 8601 formatted date: " + date);
+    }
+
+    return ((daysFromCivil(year, month, day) * 24 + hour) * 60 + minute) * 60000LL + second * 1000LL + millisecond - offset;
+}
+
+// Format milliseconds since the Unix epoch as an ISO 8601 formatted date and time (UTC)
+static std::string formatIsoDate(long long time)
+{
+    long long days = (time >= 0 ? time : time - 86399999) / 86400000;
+    unsigned int time_of_day = static_cast<unsigned int>(time - days * 86400000);
+    long long year;
+    unsigned int month, day;
+    // Room for any year that fits a long long
+    char buffer[64];
+
+    civilFromDays(days, year, month, day);
+
+    std::snprintf(buffer, sizeof(buffer), "%04lld-%02u-%02uT%02u:%02u:%02u.%03uZ", year, month, day, time_of_day / 3600000,
+            time_of_day / 60000 % 60, time_of_day / 1000 % 60, time_of_day % 1000);
+
+    return buffer;
+}
+
+// Time frame of List Messages requests, in milliseconds since the Unix epoch. If no start date is given, it starts at
+//  the Unix epoch. If no end date is given, it ends now
+static void timeFrameBoundaries(const std::string &start_date, const std::string &end_date, long long &start, long long &end)
+{
+    start = start_date.empty() ? 0 : parseIsoDate(start_date);
+    end = end_date.empty() ? std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count()
+            : parseIsoDate(end_date);
+}
+
+static void prepareRetrievePermissionRights(ctn::ApiRequest &request, const std::string &eventName)
+{
+    request.params[":eventName"] = eventName;
+}
+
+// Helpers used to serialize the permission rights of a Set Permission Rights request body
+
+static const std::string &rightsEntryId(const std::string &entry)
+{
+    return entry;
+}
+
+static const std::string &rightsEntryId(const ctn::Device &entry)
+{
+    return entry.id;
+}
+
+static void writeRightsEntry(ctn::CtnApiJsonWriter &writer, const std::string &entry)
+{
+    writer.value(entry);
+}
+
+static void writeRightsEntry(ctn::CtnApiJsonWriter &writer, const ctn::Device &entry)
+{
+    writer.beginObject()
+        .member("id").value(entry.id)
+        .member("isProdUniqueId").value(entry.isProdUniqueId)
+    .endObject();
+}
+
+// Write list of permission rights entries, leaving out entries with no ID. Nothing is written if no entries are left
+template<typename Entry>
+static void writeRightsList(ctn::CtnApiJsonWriter &writer, const char *name, const std::list<Entry> &entries)
+{
+    bool has_entries = false;
+
+    for (auto const &entry : entries) {
+        if (rightsEntryId(entry).empty()) continue;
+
+        if (!has_entries) {
+            writer.member(name).beginArray();
+            has_entries = true;
+        }
+
+        writeRightsEntry(writer, entry);
+    }
+
+    if (has_entries) writer.endArray();
+}
+
+template<typename Rights>
+static void writeRights(ctn::CtnApiJsonWriter &writer, const char *name, const Rights *rights)
+{
+    if (rights == nullptr) return;
+
+    writer.member(name).beginObject();
+
+    writeRightsList(writer, "allow", rights->allowed);
+    writeRightsList(writer, "deny", rights->denied);
+    writeRightsList(writer, "none", rights->none);
+
+    writer.endObject();
+}
+
+// Upper bound of the characters that the permission rights take once serialized
+template<typename Rights>
+static std::size_t rightsSize(const Rights *rights)
+{
+    std::size_t size = 0;
+
+    if (rights != nullptr) {
+        for (auto list : {&rights->allowed, &rights->denied, &rights->none}) {
+            for (auto const &entry : *list) {
+                size += ctn::CtnApiJsonWriter::quotedSize(rightsEntryId(entry)) + DEVICE_JSON_OVERHEAD;
+            }
+        }
+    }
+
+    return size;
+}
+
+static void prepareSetPermissionRights(ctn::ApiRequest &request, const std::string &eventName, const std::string &systemRight, ctn::SetRightsCtnNode *cntNodesRights, ctn::SetRightsClient *clientRights, ctn::SetRightsDevice *deviceRights)
+{
+    using ctn::CtnApiJsonWriter;
+
+    request.params[":eventName"] = eventName;
+
+    // write request body. Members are written with their keys sorted
+    request.payload.clear();
+    request.payload.reserve(CtnApiJsonWriter::quotedSize(systemRight) + rightsSize(cntNodesRights) + rightsSize(clientRights)
+            + rightsSize(deviceRights) + JSON_OVERHEAD);
+
+    CtnApiJsonWriter writer(request.payload);
+
+    writer.beginObject();
+
+    writeRights(writer, "catenisNode", cntNodesRights);
+    writeRights(writer, "client", clientRights);
+    writeRights(writer, "device", deviceRights);
+
+    if (!systemRight.empty()) {
+        writer.member("system").value(systemRight);
+    }
+
+    writer.endObject();
+}
+
+static void prepareCheckEffectivePermissionRight(ctn::ApiRequest &request, const std::string &eventName, const ctn::Device &device)
+{
+    request.params[":eventName"] = eventName;
+    request.params[":deviceId"] = device.id;
+
+    request.queries["isProdUniqueId"] = device.isProdUniqueId ? "true" : "false";
+}
+
+static void prepareRetrieveDeviceIdInfo(ctn::ApiRequest &request, const ctn::Device &device)
+{
+    request.params[":deviceId"] = device.id;
+
+    request.queries["isProdUniqueId"] = device.isProdUniqueId ? "true" : "false";
+}
+
+// API Method: Log Message
+void ctn::CtnApiClient::logMessage(LogMessageResult &data, const std::string &message, const MessageOptions &option)
+{
+    ApiRequest request("POST", "messages/log");
+    prepareLogMessage(request, message, option);
+
+    this->internals_->invokeApiMethod(std::move(request), &CtnApiInternals::parseLogMessage, data);
+}
+
+std::future<ctn::LogMessageResult> ctn::CtnApiClient::logMessageAsync(const std::string &message, const MessageOptions &option)
+{
+    ApiRequest request("POST", "messages/log");
+    prepareLogMessage(request, message, option);
+
+    return this->internals_->invokeApiMethodAsync<LogMessageResult>(std::move(request), &CtnApiInternals::parseLogMessage);
+}
+
+void ctn::CtnApiClient::logMessageAsync(ApiCallback<LogMessageResult> callback, const std::string &message, const MessageOptions &option)
+{
+    ApiRequest request("POST", "messages/log");
+    prepareLogMessage(request, message, option);
 
-    json_spirit::mObject objTargetDevice;
+    this->internals_->invokeApiMethodAsync<LogMessageResult>(std::move(request), &CtnApiInternals::parseLogMessage, callback);
+}
 
-    objTargetDevice["id"] = device.id;
-    objTargetDevice["isProdUniqueId"] = device.isProdUniqueId;
+void ctn::CtnApiClient::logMessages(std::vector< BatchItemResult<LogMessageResult> > &data, const std::vector<std::string> &messages, const MessageOptions &option, unsigned int max_in_flight)
+{
+    this->internals_->invokeApiMethodBatch<LogMessageResult>(messages.size(), max_in_flight, [&messages, &option](std::size_t index) {
+        ApiRequest request("POST", "messages/log");
+        prepareLogMessage(request, messages[index], option);
 
-    objData["targetDevice"] = objTargetDevice;
+        return request;
+    }, &CtnApiInternals::parseLogMessage, data);
+}
 
-    objData["message"] = message;
+// API Method: Send Message
+void ctn::CtnApiClient::sendMessage(SendMessageResult &data, const Device &device, const std::string &message, const MessageOptions &option)
+{
+    ApiRequest request("POST", "messages/send");
+    prepareSendMessage(request, device, message, option);
 
-    json_spirit::mObject objOptions;
+    this->internals_->invokeApiMethod(std::move(request), &CtnApiInternals::parseSendMessage, data);
+}
 
-    objOptions["readConfirmation"] = option.readConfirmation;
-    objOptions["encoding"] = option.encoding;
-    objOptions["encrypt"] = option.encrypt;
-    objOptions["storage"] = option.storage;
+std::future<ctn::SendMessageResult> ctn::CtnApiClient::sendMessageAsync(const Device &device, const std::string &message, const MessageOptions &option)
+{
+    ApiRequest request("POST", "messages/send");
+    prepareSendMessage(request, device, message, option);
 
-    objData["options"] = objOptions;
+    return this->internals_->invokeApiMethodAsync<SendMessageResult>(std::move(request), &CtnApiInternals::parseSendMessage);
+}
 
-    json_spirit::mValue request_data(objData);
-#elif defined(COM_SUPPORT_LIB_POCO)
-    Poco::JSON::Object request_data;
+void ctn::CtnApiClient::sendMessageAsync(ApiCallback<SendMessageResult> callback, const Device &device, const std::string &message, const MessageOptions &option)
+{
+    ApiRequest request("POST", "messages/send");
+    prepareSendMessage(request, device, message, option);
 
-    Poco::JSON::Object targetD;
-    targetD.set("id", device.id);
-    targetD.set("isProdUniqueId", device.isProdUniqueId);
-    request_data.set("targetDevice", targetD);
+    this->internals_->invokeApiMethodAsync<SendMessageResult>(std::move(request), &CtnApiInternals::parseSendMessage, callback);
+}
 
-    request_data.set("message", message);
+void ctn::CtnApiClient::sendMessage(std::vector< BatchItemResult<SendMessageResult> > &data, const std::vector<Device> &devices, const std::string &message, const MessageOptions &option, unsigned int max_parallel)
+{
+    // Message and options are serialized and hashed only once for all target devices
+    std::string common_data = prepareSendMessageCommon(message, option);
+    CtnApiSha256 common_data_hash;
+    common_data_hash.update(common_data);
 
-    Poco::JSON::Object options;
-    options.set("readConfirmation", option.readConfirmation);
-    options.set("encoding", option.encoding);
-    options.set("encrypt", option.encrypt);
-    options.set("storage", option.storage);
-    request_data.set("options", options);
-#endif
+    this->internals_->invokeApiMethodBatch<SendMessageResult>(devices.size(), max_parallel, [&devices, &common_data, &common_data_hash](std::size_t index) {
+        ApiRequest request("POST", "messages/send");
+        prepareSendMessage(request, devices[index], common_data, &common_data_hash);
 
-    std::string http_return_data;
-    this->internals_->httpRequest("POST", "messages/send", params, queries, request_data, http_return_data);
-    this->internals_->parseSendMessage(data, http_return_data); 
+        return request;
+    }, &CtnApiInternals::parseSendMessage, data);
 }
 
 // API Method: Read Message
 void ctn::CtnApiClient::readMessage(ReadMessageResult &data, std::string message_id, std::string encoding)
 {
-    std::map<std::string, std::string> params;
-    std::map<std::string, std::string> queries;
+    ApiRequest request("GET", "messages/:messageId");
+    prepareReadMessage(request, message_id, encoding);
+
+    this->internals_->invokeCachedApiMethod(this->internals_->messageCache(), readMessageCacheKey(message_id, encoding), std::move(request), &CtnApiInternals::parseReadMessage, data);
+}
+
+void ctn::CtnApiClient::readMessage(ReadMessageView &data, std::string message_id, std::string encoding)
+{
+    ApiRequest request("GET", "messages/:messageId");
+    prepareReadMessage(request, message_id, encoding);
 
-    params[":messageId"] = message_id;
-    queries["encoding"] = encoding;
+    this->internals_->invokeApiMethod(std::move(request), &CtnApiInternals::parseReadMessageView, data);
+}
+
+std::future<ctn::ReadMessageResult> ctn::CtnApiClient::readMessageAsync(std::string message_id, std::string encoding)
+{
+    ApiRequest request("GET", "messages/:messageId");
+    prepareReadMessage(request, message_id, encoding);
 
-#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-    json_spirit::mValue request_data;
-#elif defined(COM_SUPPORT_LIB_POCO)
-    Poco::JSON::Object request_data;
-#endif
+    return this->internals_->invokeCachedApiMethodAsync<ReadMessageResult>(this->internals_->messageCache(), readMessageCacheKey(message_id, encoding), std::move(request), &CtnApiInternals::parseReadMessage);
+}
+
+void ctn::CtnApiClient::readMessageAsync(ApiCallback<ReadMessageResult> callback, std::string message_id, std::string encoding)
+{
+    ApiRequest request("GET", "messages/:messageId");
+    prepareReadMessage(request, message_id, encoding);
 
-    std::string http_return_data;
-    this->internals_->httpRequest("GET", "messages/:messageId", params, queries, request_data, http_return_data);
-    this->internals_->parseReadMessage(data, http_return_data); 
+    this->internals_->invokeCachedApiMethodAsync<ReadMessageResult>(this->internals_->messageCache(), readMessageCacheKey(message_id, encoding), std::move(request), &CtnApiInternals::parseReadMessage, callback);
 }
 
 // API Method: Retreive Message Containter
 void ctn::CtnApiClient::retrieveMessageContainer(RetrieveMessageContainerResult &data, std::string message_id)
 {
-    std::map<std::string, std::string> params;
-    std::map<std::string, std::string> queries;
+    ApiRequest request("GET", "messages/:messageId/container");
+    prepareRetrieveMessageContainer(request, message_id);
 
-    params[":messageId"] = message_id;
+    this->internals_->invokeCachedApiMethod(this->internals_->containerCache(), message_id, std::move(request), &CtnApiInternals::parseRetrieveMessageContainer, data);
+}
+
+std::future<ctn::RetrieveMessageContainerResult> ctn::CtnApiClient::retrieveMessageContainerAsync(std::string message_id)
+{
+    ApiRequest request("GET", "messages/:messageId/container");
+    prepareRetrieveMessageContainer(request, message_id);
 
-#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-    json_spirit::mValue request_data;
-#elif defined(COM_SUPPORT_LIB_POCO)
-    Poco::JSON::Object request_data;
-#endif
+    return this->internals_->invokeCachedApiMethodAsync<RetrieveMessageContainerResult>(this->internals_->containerCache(), message_id, std::move(request), &CtnApiInternals::parseRetrieveMessageContainer);
+}
+
+void ctn::CtnApiClient::retrieveMessageContainerAsync(ApiCallback<RetrieveMessageContainerResult> callback, std::string message_id)
+{
+    ApiRequest request("GET", "messages/:messageId/container");
+    prepareRetrieveMessageContainer(request, message_id);
 
-    std::string http_return_data;
-    this->internals_->httpRequest("GET", "messages/:messageId/container", params, queries, request_data, http_return_data);
-    this->internals_->parseRetrieveMessageContainer(data, http_return_data); 
+    this->internals_->invokeCachedApiMethodAsync<RetrieveMessageContainerResult>(this->internals_->containerCache(), message_id, std::move(request), &CtnApiInternals::parseRetrieveMessageContainer, callback);
 }
 
 // API Method: List Messages
 void ctn::CtnApiClient::listMessages(ListMessagesResult &data, std::string action, std::string direction, std::string from_device_ids, std::string to_device_ids, std::string from_device_prod_ids, std::string to_device_prod_ids, std::string read_state, std::string start_date, std::string endDate)
 {
-    std::map<std::string, std::string> params;
-    std::map<std::string, std::string> queries;
+    ApiRequest request("GET", "messages");
+    prepareListMessages(request, action, direction, from_device_ids, to_device_ids, from_device_prod_ids, to_device_prod_ids, read_state, start_date, endDate);
 
-    queries["action"] = action;
-    queries["direction"] = direction;
-    
-    if(!from_device_ids.empty()) queries["fromDeviceIds"] = from_device_ids;
-    if(!to_device_ids.empty()) queries["toDeviceIds"] = to_device_ids;
-    if(!from_device_prod_ids.empty()) queries["fromDeviceProdUniqueIds"] = from_device_prod_ids;
-    if(!to_device_prod_ids.empty()) queries["toDeviceProdUniqueIds"] = to_device_prod_ids;
-    
-    queries["readState"] = read_state;
-    
-    if(!start_date.empty()) queries["startDate"] = start_date;
-    if(!endDate.empty()) queries["endDate"] = endDate;
+    this->internals_->invokeApiMethod(std::move(request), &CtnApiInternals::parseListMessages, data);
+}
+
+void ctn::CtnApiClient::listMessages(FlatListMessagesResult &data, std::string action, std::string direction, std::string from_device_ids, std::string to_device_ids, std::string from_device_prod_ids, std::string to_device_prod_ids, std::string read_state, std::string start_date, std::string endDate)
+{
+    ApiRequest request("GET", "messages");
+    prepareListMessages(request, action, direction, from_device_ids, to_device_ids, from_device_prod_ids, to_device_prod_ids, read_state, start_date, endDate);
+
+    this->internals_->invokeApiMethod(std::move(request), &CtnApiInternals::parseListMessagesFlat, data);
+}
+
+void ctn::CtnApiClient::listMessages(ArenaListMessagesResult &data, std::string action, std::string direction, std::string from_device_ids, std::string to_device_ids, std::string from_device_prod_ids, std::string to_device_prod_ids, std::string read_state, std::string start_date, std::string endDate)
+{
+    ApiRequest request("GET", "messages");
+    prepareListMessages(request, action, direction, from_device_ids, to_device_ids, from_device_prod_ids, to_device_prod_ids, read_state, start_date, endDate);
+
+    this->internals_->invokeApiMethod(std::move(request), &CtnApiInternals::parseListMessagesArena, data);
+}
+
+void ctn::CtnApiClient::listMessages(ListMessagesView &data, std::string action, std::string direction, std::string from_device_ids, std::string to_device_ids, std::string from_device_prod_ids, std::string to_device_prod_ids, std::string read_state, std::string start_date, std::string endDate)
+{
+    ApiRequest request("GET", "messages");
+    prepareListMessages(request, action, direction, from_device_ids, to_device_ids, from_device_prod_ids, to_device_prod_ids, read_state, start_date, endDate);
+
+    this->internals_->invokeApiMethod(std::move(request), &CtnApiInternals::parseListMessagesView, data);
+}
+
+std::future<ctn::ListMessagesResult> ctn::CtnApiClient::listMessagesAsync(std::string action, std::string direction, std::string from_device_ids, std::string to_device_ids, std::string from_device_prod_ids, std::string to_device_prod_ids, std::string read_state, std::string start_date, std::string endDate)
+{
+    ApiRequest request("GET", "messages");
+    prepareListMessages(request, action, direction, from_device_ids, to_device_ids, from_device_prod_ids, to_device_prod_ids, read_state, start_date, endDate);
+
+    return this->internals_->invokeApiMethodAsync<ListMessagesResult>(std::move(request), &CtnApiInternals::parseListMessages);
+}
+
+void ctn::CtnApiClient::listMessagesAsync(ApiCallback<ListMessagesResult> callback, std::string action, std::string direction, std::string from_device_ids, std::string to_device_ids, std::string from_device_prod_ids, std::string to_device_prod_ids, std::string read_state, std::string start_date, std::string endDate)
+{
+    ApiRequest request("GET", "messages");
+    prepareListMessages(request, action, direction, from_device_ids, to_device_ids, from_device_prod_ids, to_device_prod_ids, read_state, start_date, endDate);
+
+    this->internals_->invokeApiMethodAsync<ListMessagesResult>(std::move(request), &CtnApiInternals::parseListMessages, callback);
+}
+
+ctn::MessageIterator ctn::CtnApiClient::iterateMessages(std::string action, std::string direction, std::string from_device_ids, std::string to_device_ids, std::string from_device_prod_ids, std::string to_device_prod_ids, std::string read_state, std::string start_date, std::string end_date)
+{
+    return MessageIterator(*this, action, direction, from_device_ids, to_device_ids, from_device_prod_ids, to_device_prod_ids, read_state, start_date, end_date);
+}
 
-#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-    json_spirit::mValue request_data;
-#elif defined(COM_SUPPORT_LIB_POCO)
-    Poco::JSON::Object request_data;
-#endif
+void ctn::CtnApiClient::scanMessages(ListMessagesResult &data, std::string action, std::string direction, std::string from_device_ids, std::string to_device_ids, std::string from_device_prod_ids, std::string to_device_prod_ids, std::string read_state, std::string start_date, std::string end_date, unsigned int max_in_flight)
+{
+    long long start, end;
+
+    timeFrameBoundaries(start_date, end_date, start, end);
+
+    this->internals_->invokeMessageScan(start, end, max_in_flight, [&](long long frame_start, long long frame_end) {
+        ApiRequest request("GET", "messages");
+        prepareListMessages(request, action, direction, from_device_ids, to_device_ids, from_device_prod_ids, to_device_prod_ids, read_state, formatIsoDate(frame_start), formatIsoDate(frame_end));
 
-    std::string http_return_data;
-    this->internals_->httpRequest("GET", "messages", params, queries, request_data, http_return_data);
-    this->internals_->parseListMessages(data, http_return_data);
+        return request;
+    }, data);
 }
 
 // API Method: List Permission Events
 void ctn::CtnApiClient::listPermissionEvents(ListPermissionEventsResult &data)
 {
-    std::map<std::string, std::string> params;
-    std::map<std::string, std::string> queries;
+    ApiRequest request("GET", "permission/events");
 
-#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-    json_spirit::mValue request_data;
-#elif defined(COM_SUPPORT_LIB_POCO)
-    Poco::JSON::Object request_data;
-#endif
-    std::string http_return_data;
-    this->internals_->httpRequest("GET", "permission/events", params, queries, request_data, http_return_data);
-    this->internals_->parseListPermissionEvents(data, http_return_data);
+    this->internals_->invokeApiMethod(std::move(request), &CtnApiInternals::parseListPermissionEvents, data);
 }
 
-// API Method: Retrieve Permission Rights
-void ctn::CtnApiClient::retrievePermissionRights(RetrievePermissionRightsResult &data, std::string eventName)
+std::future<ctn::ListPermissionEventsResult> ctn::CtnApiClient::listPermissionEventsAsync()
 {
-    std::map<std::string, std::string> params;
-    std::map<std::string, std::string> queries;
-
-    params[":eventName"] = eventName;
+    ApiRequest request("GET", "permission/events");
 
-#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-    json_spirit::mValue request_data;
-#elif defined(COM_SUPPORT_LIB_POCO)
-    Poco::JSON::Object request_data;
-#endif
-    std::string http_return_data;
-    this->internals_->httpRequest("GET", "permission/events/:eventName/rights", params, queries, request_data, http_return_data);
-    this->internals_->parseRetrievePermissionRights(data, http_return_data);
+    return this->internals_->invokeApiMethodAsync<ListPermissionEventsResult>(std::move(request), &CtnApiInternals::parseListPermissionEvents);
 }
 
-// API Method: Set Permission Rights
-void ctn::CtnApiClient::setPermissionRights(SetPermissionRightsResult &data, std::string eventName, std::string systemRight, SetRightsCtnNode *cntNodesRights = nullptr, SetRightsClient *clientRights = nullptr, SetRightsDevice *deviceRights = nullptr)
+void ctn::CtnApiClient::listPermissionEventsAsync(ApiCallback<ListPermissionEventsResult> callback)
 {
-    std::map<std::string, std::string> params;
-    std::map<std::string, std::string> queries;
+    ApiRequest request("GET", "permission/events");
 
-    params[":eventName"] = eventName;
+    this->internals_->invokeApiMethodAsync<ListPermissionEventsResult>(std::move(request), &CtnApiInternals::parseListPermissionEvents, callback);
+}
 
-#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-    json_spirit::mObject objData;
+// API Method: Retrieve Permission Rights
+void ctn::CtnApiClient::retrievePermissionRights(RetrievePermissionRightsResult &data, std::string eventName)
+{
+    ApiRequest request("GET", "permission/events/:eventName/rights");
+    prepareRetrievePermissionRights(request, eventName);
 
-    std::list<std::string> allowed;
-    std::list<std::string> denied;
+    this->internals_->invokeApiMethod(std::move(request), &CtnApiInternals::parseRetrievePermissionRights, data);
+}
 
-    // //////////////////////////// Prepare JSON for System Level ////////////////////////////////
-    if (!systemRight.empty())
-        objData["system"] = systemRight;
+void ctn::CtnApiClient::retrievePermissionRights(ArenaRetrievePermissionRightsResult &data, std::string eventName)
+{
+    ApiRequest request("GET", "permission/events/:eventName/rights");
+    prepareRetrievePermissionRights(request, eventName);
 
-    // //////////////////////////// Prepare JSON for Catenis Node Level ////////////////////////////////
-    if (cntNodesRights != nullptr)
-    {
-        json_spirit::mObject ctnNode;
+    this->internals_->invokeApiMethod(std::move(request), &CtnApiInternals::parseRetrievePermissionRightsArena, data);
+}
 
-        if (cntNodesRights->allowed.size() > 0)
-        {
-            json_spirit::mArray allowCtnNode;
-            for (std::list<std::string>::const_iterator i = cntNodesRights->allowed.begin(); i != cntNodesRights->allowed.end(); ++i)
-            {
-                if (!(*i).empty())
-                    allowCtnNode.push_back(*i);
-            }
-            if (allowCtnNode.size() > 0)
-                ctnNode["allow"] = allowCtnNode;
-        }
-        if (cntNodesRights->denied.size() > 0)
-        {
-            json_spirit::mArray denyCtnNode;
-            for (std::list<std::string>::const_iterator i = cntNodesRights->denied.begin(); i != cntNodesRights->denied.end(); ++i)
-            {
-                if (!(*i).empty())
-                    denyCtnNode.push_back(*i);
-            }
-            if (denyCtnNode.size() > 0)
-                ctnNode["deny"] = denyCtnNode;
-        }
-        if (cntNodesRights->none.size() > 0)
-        {
-            json_spirit::mArray noneCtnNode;
-            for (std::list<std::string>::const_iterator i = cntNodesRights->none.begin(); i != cntNodesRights->none.end(); ++i)
-            {
-                if (!(*i).empty())
-                    noneCtnNode.push_back(*i);
-            }
-            if (noneCtnNode.size() > 0)
-                ctnNode["none"] = noneCtnNode;
-        }
-        objData["catenisNode"] = ctnNode;
-    }
+std::future<ctn::RetrievePermissionRightsResult> ctn::CtnApiClient::retrievePermissionRightsAsync(std::string eventName)
+{
+    ApiRequest request("GET", "permission/events/:eventName/rights");
+    prepareRetrievePermissionRights(request, eventName);
 
+    return this->internals_->invokeApiMethodAsync<RetrievePermissionRightsResult>(std::move(request), &CtnApiInternals::parseRetrievePermissionRights);
+}
 
-    // //////////////////////////// Prepare JSON for Client Level ////////////////////////////////
-    if (clientRights != nullptr)
-    {
-        json_spirit::mObject client;
+void ctn::CtnApiClient::retrievePermissionRightsAsync(ApiCallback<RetrievePermissionRightsResult> callback, std::string eventName)
+{
+    ApiRequest request("GET", "permission/events/:eventName/rights");
+    prepareRetrievePermissionRights(request, eventName);
 
-        if (clientRights->allowed.size() > 0)
-        {
-            json_spirit::mArray allowClient;
-            for (std::list<std::string>::const_iterator i = clientRights->allowed.begin(); i != clientRights->allowed.end(); ++i)
-            {
-                if (!(*i).empty())
-                    allowClient.push_back(*i);
-            }
-            if (allowClient.size() > 0)
-                client["allow"] = allowClient;
-        }
-        if (clientRights->denied.size() > 0)
-        {
-            json_spirit::mArray denyClient;
-            for (std::list<std::string>::const_iterator i = clientRights->denied.begin(); i != clientRights->denied.end(); ++i)
-            {
-                if (!(*i).empty())
-                    denyClient.push_back(*i);
-            }
-            if (denyClient.size() > 0)
-                client["deny"] = denyClient;
-        }
-        if (clientRights->none.size() > 0)
-        {
-            json_spirit::mArray noneClient;
-            for (std::list<std::string>::const_iterator i = clientRights->none.begin(); i != clientRights->none.end(); ++i)
-            {
-                if (!(*i).empty())
-                    noneClient.push_back(*i);
-            }
-            if (noneClient.size() > 0)
-                client["none"] = noneClient;
-        }
-        objData["client"] = client;
-    }
+    this->internals_->invokeApiMethodAsync<RetrievePermissionRightsResult>(std::move(request), &CtnApiInternals::parseRetrievePermissionRights, callback);
+}
 
-    // //////////////////////////// Prepare JSON for Device Level ////////////////////////////////
-    if (deviceRights != nullptr)
-    {
-        json_spirit::mObject device;
-        if (deviceRights->allowed.size() > 0)
-        {
-            json_spirit::mArray allowDevice;
-            json_spirit::mObject tmpObj;
-            for (std::list<Device>::iterator i = deviceRights->allowed.begin(); i != deviceRights->allowed.end(); ++i)
-            {
-                if (!(*i).id.empty())
-                {
-                    tmpObj["id"] = (*i).id;
-                    tmpObj["isProdUniqueId"] = (*i).isProdUniqueId;
-                    allowDevice.push_back(tmpObj);
-                }
-            }
-            if (allowDevice.size() > 0)
-                device["allow"] = allowDevice;
-        }
-        if (deviceRights->denied.size() > 0)
-        {
-            json_spirit::mArray denyDevice;
-            json_spirit::mObject tmpObj;
-            for (std::list<Device>::iterator i = deviceRights->denied.begin(); i != deviceRights->denied.end(); ++i)
-            {
-                if (!(*i).id.empty())
-                {
-                    tmpObj["id"] = (*i).id;
-                    tmpObj["isProdUniqueId"] = (*i).isProdUniqueId;
-                    denyDevice.push_back(tmpObj);
-                }
-            }
-            if (denyDevice.size() > 0)
-                device["deny"] = denyDevice;
-        }
-        if (deviceRights->none.size() > 0)
-        {
-            json_spirit::mArray noneevice;
-            json_spirit::mObject tmpObj;
-            for (std::list<Device>::iterator i = deviceRights->none.begin(); i != deviceRights->none.end(); ++i)
-            {
-                if (!(*i).id.empty())
-                {
-                    tmpObj["id"] = (*i).id;
-                    tmpObj["isProdUniqueId"] = (*i).isProdUniqueId;
-                    noneevice.push_back(tmpObj);
-                }
-            }
-            if (noneevice.size() > 0)
-                device["none"] = noneevice;
-        }
-        objData["device"] = device;
-    }
+// API Method: Set Permission Rights
+void ctn::CtnApiClient::setPermissionRights(SetPermissionRightsResult &data, std::string eventName, std::string systemRight, SetRightsCtnNode *cntNodesRights = nullptr, SetRightsClient *clientRights = nullptr, SetRightsDevice *deviceRights = nullptr)
+{
+    ApiRequest request("POST", "permission/events/:eventName/rights");
+    prepareSetPermissionRights(request, eventName, systemRight, cntNodesRights, clientRights, deviceRights);
 
-    json_spirit::mValue request_data(objData);
-
-#elif defined(COM_SUPPORT_LIB_POCO)
-    Poco::JSON::Object request_data;
-
-    std::list<std::string> allowed;
-    std::list<std::string> denied;
-
-    // //////////////////////////// Prepare JSON for System Level ////////////////////////////////
-    if (!systemRight.empty())
-        request_data.set("system", systemRight);
-
-    // //////////////////////////// Prepare JSON for Catenis Node Level ////////////////////////////////
-    if (cntNodesRights != nullptr)
-    {
-        Poco::JSON::Object ctnNode;
-        if (cntNodesRights->allowed.size() > 0)
-        {
-            Poco::JSON::Array allowCtnNode;
-            for (std::list<std::string>::const_iterator i = cntNodesRights->allowed.begin(); i != cntNodesRights->allowed.end(); ++i)
-            {
-                if (!(*i).empty())
-                    allowCtnNode.add(*i);
-            }
-            if(allowCtnNode.size() > 0)
-                ctnNode.set("allow", allowCtnNode);
-        }
-        if (cntNodesRights->denied.size() > 0)
-        {
-            Poco::JSON::Array denyCtnNode;
-            for (std::list<std::string>::const_iterator i = cntNodesRights->denied.begin(); i != cntNodesRights->denied.end(); ++i)
-            {
-                if (!(*i).empty())
-                    denyCtnNode.add(*i);
-            }
-            if (denyCtnNode.size() > 0)
-                ctnNode.set("deny", denyCtnNode);
-        }
-        if (cntNodesRights->none.size() > 0)
-        {
-            Poco::JSON::Array noneCtnNode;
-            for (std::list<std::string>::const_iterator i = cntNodesRights->none.begin(); i != cntNodesRights->none.end(); ++i)
-            {
-                if (!(*i).empty())
-                    noneCtnNode.add(*i);
-            }
-            if (noneCtnNode.size() > 0)
-                ctnNode.set("none", noneCtnNode);
-        }
-        request_data.set("catenisNode", ctnNode);
-    }
+    this->internals_->invokeApiMethod(std::move(request), &CtnApiInternals::parseSetPermissionRights, data);
+}
 
-    // //////////////////////////// Prepare JSON for Client Level ////////////////////////////////
-    if (clientRights != nullptr)
-    {
-        Poco::JSON::Object client;
-        if (clientRights->allowed.size() > 0)
-        {
-            Poco::JSON::Array allowClient;
-            for (std::list<std::string>::const_iterator i = clientRights->allowed.begin(); i != clientRights->allowed.end(); ++i)
-            {
-                if (!(*i).empty())
-                    allowClient.add(*i);
-            }
-            if (allowClient.size() > 0)
-                client.set("allow", allowClient);
-        }
-        if (clientRights->denied.size() > 0)
-        {
-            Poco::JSON::Array denyClient;
-            for (std::list<std::string>::const_iterator i = clientRights->denied.begin(); i != clientRights->denied.end(); ++i)
-            {
-                if (!(*i).empty())
-                    denyClient.add(*i);
-            }
-            if (denyClient.size() > 0)
-                client.set("deny", denyClient);
-        }
-        if (clientRights->none.size() > 0)
-        {
-            Poco::JSON::Array noneClient;
-            for (std::list<std::string>::const_iterator i = clientRights->none.begin(); i != clientRights->none.end(); ++i)
-            {
-                if (!(*i).empty())
-                    noneClient.add(*i);
-            }
-            if (noneClient.size() > 0)
-                client.set("none", noneClient);
-        }
-        request_data.set("client", client);
-    }
+std::future<ctn::SetPermissionRightsResult> ctn::CtnApiClient::setPermissionRightsAsync(std::string eventName, std::string systemRight, SetRightsCtnNode *cntNodesRights, SetRightsClient *clientRights, SetRightsDevice *deviceRights)
+{
+    ApiRequest request("POST", "permission/events/:eventName/rights");
+    prepareSetPermissionRights(request, eventName, systemRight, cntNodesRights, clientRights, deviceRights);
 
-    // //////////////////////////// Prepare JSON for Device Level ////////////////////////////////
-    if (deviceRights != nullptr)
-    {
-        Poco::JSON::Object device;
-        if (deviceRights->allowed.size() > 0)
-        {
-            Poco::JSON::Array allowDevice;
-            Poco::JSON::Object tmpObj;
-            for (std::list<Device>::iterator i = deviceRights->allowed.begin(); i != deviceRights->allowed.end(); ++i)
-            {
-                if (!(*i).id.empty())
-                {
-                    tmpObj.set("id", (*i).id);
-                    tmpObj.set("isProdUniqueId", (*i).isProdUniqueId);
-                    allowDevice.add(tmpObj);
-                }
-            }
-            if (allowDevice.size() > 0)
-                device.set("allow", allowDevice);
-        }
-        if (deviceRights->denied.size() > 0)
-        {
-            Poco::JSON::Array denyDevice;
-            Poco::JSON::Object tmpObj;
-            for (std::list<Device>::iterator i = deviceRights->denied.begin(); i != deviceRights->denied.end(); ++i)
-            {
-                if (!(*i).id.empty())
-                {
-                    tmpObj.set("id", (*i).id);
-                    tmpObj.set("isProdUniqueId", (*i).isProdUniqueId);
-                    denyDevice.add(tmpObj);
-                }
-            }
-            if (denyDevice.size() > 0)
-                device.set("deny", denyDevice);
-        }
-        if (deviceRights->none.size() > 0)
-        {
-            Poco::JSON::Array noneevice;
-            Poco::JSON::Object tmpObj;
-            for (std::list<Device>::iterator i = deviceRights->none.begin(); i != deviceRights->none.end(); ++i)
-            {
-                if (!(*i).id.empty())
-                {
-                    tmpObj.set("id", (*i).id);
-                    tmpObj.set("isProdUniqueId", (*i).isProdUniqueId);
-                    noneevice.add(tmpObj);
-                }
-            }
-            if (noneevice.size() > 0)
-                device.set("none", noneevice);
-        }
-        request_data.set("device", device);
-    }
+    return this->internals_->invokeApiMethodAsync<SetPermissionRightsResult>(std::move(request), &CtnApiInternals::parseSetPermissionRights);
+}
+
+void ctn::CtnApiClient::setPermissionRightsAsync(ApiCallback<SetPermissionRightsResult> callback, std::string eventName, std::string systemRight, SetRightsCtnNode *cntNodesRights, SetRightsClient *clientRights, SetRightsDevice *deviceRights)
+{
+    ApiRequest request("POST", "permission/events/:eventName/rights");
+    prepareSetPermissionRights(request, eventName, systemRight, cntNodesRights, clientRights, deviceRights);
 
-#endif
-    std::string http_return_data;
-    this->internals_->httpRequest("POST", "permission/events/:eventName/rights", params, queries, request_data, http_return_data);
-    this->internals_->parseSetPermissionRights(data, http_return_data);
+    this->internals_->invokeApiMethodAsync<SetPermissionRightsResult>(std::move(request), &CtnApiInternals::parseSetPermissionRights, callback);
 }
 
 // API Method: List Notification Events
 void ctn::CtnApiClient::listNotificationEvents(ListNotificationEventsResult &data)
 {
-    std::map<std::string, std::string> params;
-    std::map<std::string, std::string> queries;
+    ApiRequest request("GET", "notification/events");
+
+    this->internals_->invokeApiMethod(std::move(request), &CtnApiInternals::parseListNotificationEvents, data);
+}
+
+std::future<ctn::ListNotificationEventsResult> ctn::CtnApiClient::listNotificationEventsAsync()
+{
+    ApiRequest request("GET", "notification/events");
+
+    return this->internals_->invokeApiMethodAsync<ListNotificationEventsResult>(std::move(request), &CtnApiInternals::parseListNotificationEvents);
+}
+
+void ctn::CtnApiClient::listNotificationEventsAsync(ApiCallback<ListNotificationEventsResult> callback)
+{
+    ApiRequest request("GET", "notification/events");
 
-#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-    json_spirit::mValue request_data;
-#elif defined(COM_SUPPORT_LIB_POCO)
-    Poco::JSON::Object request_data;
-#endif
-    std::string http_return_data;
-    this->internals_->httpRequest("GET", "notification/events", params, queries, request_data, http_return_data);
-    this->internals_->parseListNotificationEvents(data, http_return_data);
+    this->internals_->invokeApiMethodAsync<ListNotificationEventsResult>(std::move(request), &CtnApiInternals::parseListNotificationEvents, callback);
 }
 
 // API Method: Check Effective Permission Events
 void ctn::CtnApiClient::checkEffectivePermissionRight(CheckEffectivePermissionRightResult &data, std::string eventName, Device device)
 {
-    std::map<std::string, std::string> params;
-    std::map<std::string, std::string> queries;
+    ApiRequest request("GET", "permission/events/:eventName/rights/:deviceId");
+    prepareCheckEffectivePermissionRight(request, eventName, device);
+
+    this->internals_->invokeApiMethod(std::move(request), &CtnApiInternals::parseCheckEffectivePermissionRight, data);
+}
+
+std::future<ctn::CheckEffectivePermissionRightResult> ctn::CtnApiClient::checkEffectivePermissionRightAsync(std::string eventName, Device device)
+{
+    ApiRequest request("GET", "permission/events/:eventName/rights/:deviceId");
+    prepareCheckEffectivePermissionRight(request, eventName, device);
 
-    params[":eventName"] = eventName;
-    params[":deviceId"] = device.id;
+    return this->internals_->invokeApiMethodAsync<CheckEffectivePermissionRightResult>(std::move(request), &CtnApiInternals::parseCheckEffectivePermissionRight);
+}
 
-    queries["isProdUniqueId"] = device.isProdUniqueId ? "true" : "false";
+void ctn::CtnApiClient::checkEffectivePermissionRightAsync(ApiCallback<CheckEffectivePermissionRightResult> callback, std::string eventName, Device device)
+{
+    ApiRequest request("GET", "permission/events/:eventName/rights/:deviceId");
+    prepareCheckEffectivePermissionRight(request, eventName, device);
 
-#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-    json_spirit::mValue request_data;
-#elif defined(COM_SUPPORT_LIB_POCO)
-    Poco::JSON::Object request_data;
-#endif
-    std::string http_return_data;
-    this->internals_->httpRequest("GET", "permission/events/:eventName/rights/:deviceId", params, queries, request_data, http_return_data);
-    this->internals_->parseCheckEffectivePermissionRight(data, http_return_data);
+    this->internals_->invokeApiMethodAsync<CheckEffectivePermissionRightResult>(std::move(request), &CtnApiInternals::parseCheckEffectivePermissionRight, callback);
 }
 
-// API Method: Check Effective Permission Events
+// API Method: Retrieve Device Identification Info
 void ctn::CtnApiClient::retrieveDeviceIdInfo(DeviceIdInfoResult &data, Device device)
 {
+    ApiRequest request("GET", "devices/:deviceId");
+    prepareRetrieveDeviceIdInfo(request, device);
+
+    this->internals_->invokeApiMethod(std::move(request), &CtnApiInternals::parseRetrieveDeviceIdInfo, data);
+}
+
+std::future<ctn::DeviceIdInfoResult> ctn::CtnApiClient::retrieveDeviceIdInfoAsync(Device device)
+{
+    ApiRequest request("GET", "devices/:deviceId");
+    prepareRetrieveDeviceIdInfo(request, device);
+
+    return this->internals_->invokeApiMethodAsync<DeviceIdInfoResult>(std::move(request), &CtnApiInternals::parseRetrieveDeviceIdInfo);
+}
+
+void ctn::CtnApiClient::retrieveDeviceIdInfoAsync(ApiCallback<DeviceIdInfoResult> callback, Device device)
+{
+    ApiRequest request("GET", "devices/:deviceId");
+    prepareRetrieveDeviceIdInfo(request, device);
 
-    std::map<std::string, std::string> params;
-    std::map<std::string, std::string> queries;
+    this->internals_->invokeApiMethodAsync<DeviceIdInfoResult>(std::move(request), &CtnApiInternals::parseRetrieveDeviceIdInfo, callback);
+}
 
-    params[":deviceId"] = device.id;
+ctn::TlsSessionStats ctn::CtnApiClient::getTlsSessionStats()
+{
+    return this->internals_->tlsSessionStats();
+}
 
-    queries["isProdUniqueId"] = device.isProdUniqueId ? "true" : "false";
+ctn::SchedulerStats ctn::CtnApiClient::getSchedulerStats()
+{
+    return this->internals_->schedulerStats();
+}
 
-#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-    json_spirit::mValue request_data;
-#elif defined(COM_SUPPORT_LIB_POCO)
-    Poco::JSON::Object request_data;
-#endif
-    std::string http_return_data;
-    this->internals_->httpRequest("GET", "devices/:deviceId", params, queries, request_data, http_return_data);
-    this->internals_->parseRetrieveDeviceIdInfo(data, http_return_data);
+ctn::ResultCacheStats ctn::CtnApiClient::getResultCacheStats()
+{
+    return this->internals_->resultCacheStats();
 }
 
 // CtnApiClient Constructor
-ctn::CtnApiClient::CtnApiClient(std::string device_id, std::string api_access_secret, std::string host, std::string port, std::string environment, bool secure, std::string version)
+ctn::CtnApiClient::CtnApiClient(std::string device_id, std::string api_access_secret, std::string host, std::string port, std::string environment, bool secure, std::string version, const ClientOptions &options)
 {
     // Init internals and pass param
-    this->internals_ = new ctn::CtnApiInternals(device_id, api_access_secret, host, port, environment, secure, version);
+    this->internals_ = new ctn::CtnApiInternals(device_id, api_access_secret, host, port, environment, secure, version, options);
 }
 
 // CtnApiClient Destructor
@@ -593,3 +789,143 @@ ctn::CtnApiClient::~CtnApiClient()
 {
     delete this->internals_;
 }
+
+// View results
+
+std::string ctn::JsonStringView::str() const
+{
+    if (this->escaped_) return CtnApiJsonReader::unescape(this->data_, this->size_);
+
+    return std::string(this->data_, this->size_);
+}
+
+bool ctn::JsonStringView::operator==(const std::string &value) const
+{
+    if (this->escaped_) return str() == value;
+
+    return this->size_ == value.size() && value.compare(0, std::string::npos, this->data_, this->size_) == 0;
+}
+
+std::shared_ptr<ctn::DeviceInfo> ctn::DeviceInfoView::materialize() const
+{
+    return std::make_shared<DeviceInfo>(this->deviceId.str(), this->name.str(), this->prodUniqueId.str());
+}
+
+ctn::ReadMessageResult ctn::ReadMessageView::materialize() const
+{
+    ReadMessageResult result;
+
+    result.action = this->action.str();
+    if (this->hasFrom) result.from = this->from.materialize();
+    result.message = this->message.str();
+
+    return result;
+}
+
+std::shared_ptr<ctn::MessageDescription> ctn::MessageDescriptionView::materialize() const
+{
+    std::shared_ptr<bool> read_confirmation_enabled;
+    std::shared_ptr<bool> read_arg;
+
+    if (this->hasReadConfirmationEnabled) read_confirmation_enabled = std::make_shared<bool>(this->readConfirmationEnabled);
+    if (this->hasRead) read_arg = std::make_shared<bool>(this->read);
+
+    return std::make_shared<MessageDescription>(this->messageId.str(), this->action.str(), this->direction.str(),
+            this->hasFrom ? this->from.materialize() : nullptr, this->hasTo ? this->to.materialize() : nullptr, read_confirmation_enabled,
+            read_arg, this->date.str());
+}
+
+ctn::ListMessagesResult ctn::ListMessagesView::materialize() const
+{
+    ListMessagesResult result;
+
+    for (auto const &message : this->messages) {
+        result.messageList.push_back(message.materialize());
+    }
+
+    result.msgCount = this->msgCount;
+    result.countExceeded = this->countExceeded;
+
+    return result;
+}
+
+// Innermost request timeouts override of each thread
+static thread_local const ctn::RequestTimeoutsOverride *current_timeouts_override = nullptr;
+
+// RequestTimeoutsOverride Constructor
+ctn::RequestTimeoutsOverride::RequestTimeoutsOverride(const RequestTimeouts &timeouts)
+    : timeouts_(timeouts), previous_(current_timeouts_override)
+{
+    current_timeouts_override = this;
+}
+
+// RequestTimeoutsOverride Destructor
+ctn::RequestTimeoutsOverride::~RequestTimeoutsOverride()
+{
+    current_timeouts_override = this->previous_;
+}
+
+const ctn::RequestTimeoutsOverride *ctn::RequestTimeoutsOverride::current()
+{
+    return current_timeouts_override;
+}
+
+// MessageIterator Constructor
+ctn::MessageIterator::MessageIterator(CtnApiClient &client, std::string action, std::string direction, std::string from_device_ids, std::string to_device_ids, std::string from_device_prod_ids, std::string to_device_prod_ids, std::string read_state, std::string start_date, std::string end_date)
+    : client_(&client), action_(action), direction_(direction), from_device_ids_(from_device_ids), to_device_ids_(to_device_ids),
+    from_device_prod_ids_(from_device_prod_ids), to_device_prod_ids_(to_device_prod_ids), read_state_(read_state), count_exceeded_(false)
+{
+    TimeFrame frame;
+
+    timeFrameBoundaries(start_date, end_date, frame.start, frame.end);
+
+    if (frame.start <= frame.end) this->frames_.push_back(frame);
+
+    requestNextFrame();
+}
+
+bool ctn::MessageIterator::next(std::shared_ptr<MessageDescription> &message)
+{
+    while (this->messages_.empty()) {
+        if (!this->pending_.valid()) return false;
+
+        ListMessagesResult result = this->pending_.get();
+        TimeFrame frame = this->pending_frame_;
+
+        if (result.countExceeded && frame.start < frame.end) {
+            // Too many messages. Retrieve each half of the time frame instead, the earliest one first
+            long long middle = frame.start + (frame.end - frame.start) / 2;
+
+            this->frames_.push_back(TimeFrame{middle + 1, frame.end});
+            this->frames_.push_back(TimeFrame{frame.start, middle});
+        }
+        else {
+            // Time frame that cannot be split any further may still leave some messages out
+            if (result.countExceeded) this->count_exceeded_ = true;
+
+            this->messages_.swap(result.messageList);
+        }
+
+        // Retrieve the next time frame while the messages of this one are consumed
+        requestNextFrame();
+    }
+
+    message = std::move(this->messages_.front());
+    this->messages_.pop_front();
+
+    return true;
+}
+
+void ctn::MessageIterator::requestNextFrame()
+{
+    if (this->frames_.empty()) {
+        this->pending_ = std::future<ListMessagesResult>();
+        return;
+    }
+
+    this->pending_frame_ = this->frames_.back();
+    this->frames_.pop_back();
+
+    this->pending_ = this->client_->listMessagesAsync(this->action_, this->direction_, this->from_device_ids_, this->to_device_ids_, this->from_device_prod_ids_,
+            this->to_device_prod_ids_, this->read_state_, formatIsoDate(this->pending_frame_.start), formatIsoDate(this->pending_frame_.end));
+}
@@ -0,0 +1,462 @@
+//
+//  CatenisApiConnectionPool.cpp
+//  CatenisAPIClientCpp
+//
+
+#include <string>
+#include <memory>
+#include <utility>
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+#include <boost/asio/connect.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/ssl/error.hpp>
+#elif defined(COM_SUPPORT_LIB_POCO)
+#include <Poco/Timespan.h>
+#include <Poco/Net/HTTPSClientSession.h>
+#include <Poco/Net/SecureStreamSocket.h>
+#endif
+
+#include <openssl/ssl.h>
+
+#include <CatenisApiConnectionPool.h>
+#include <CatenisApiResolver.h>
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+using boost::asio::ip::tcp;
+namespace ssl = boost::asio::ssl;
+#endif
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+namespace
+{
+
+class TimeoutCategory : public boost::system::error_category
+{
+public:
+    const char *name() const noexcept override { return "ctn.timeout"; }
+
+    std::string message(int ev) const override
+    {
+        switch (static_cast<ctn::TimeoutPhase>(ev)) {
+            case ctn::TimeoutPhase::connect: return "connect";
+            case ctn::TimeoutPhase::tlsHandshake: return "TLS handshake";
+            case ctn::TimeoutPhase::send: return "send";
+            case ctn::TimeoutPhase::receive: return "receive";
+            case ctn::TimeoutPhase::deadline: return "deadline";
+        }
+
+        return "unknown";
+    }
+};
+
+}
+
+/*
+ * State of a connection being opened
+ *
+ * @member phase : Phase being timed, if any. The timer's handler checks it, since it may already be queued when the
+ *  phase completes
+ * @member timeout : Error of the phase that timed out, if any
+ */
+struct PendingConnection
+{
+    std::unique_ptr<ctn::CtnApiConnection> connection;
+    ctn::CtnApiConnectionPool::AcquireHandler handler;
+    boost::asio::steady_timer timer;
+    int phase;
+    boost::system::error_code timeout;
+
+    PendingConnection(boost::asio::io_context &ioc, ctn::CtnApiConnectionPool::AcquireHandler handler_arg)
+        : connection(new ctn::CtnApiConnection()), handler(handler_arg), timer(ioc), phase(0) {}
+
+    // Close the connection if the phase does not complete within the given time (0: no limit)
+    static void startPhase(std::shared_ptr<PendingConnection> pending, ctn::TimeoutPhase phase, unsigned int timeout)
+    {
+        pending->phase = static_cast<int>(phase);
+
+        if (timeout == 0) return;
+
+        pending->timer.expires_after(std::chrono::milliseconds(timeout));
+        pending->timer.async_wait([pending, phase](const boost::system::error_code &ec) {
+            if (ec || pending->phase != static_cast<int>(phase)) return;
+
+            // Pending operation completes with an error, which is reported as the timeout
+            pending->timeout = ctn::makeTimeoutError(phase);
+
+            boost::system::error_code ignored;
+            pending->connection->lowestLayer().close(ignored);
+        });
+    }
+
+    void endPhase()
+    {
+        phase = 0;
+        timer.cancel();
+    }
+};
+
+// Index of the TLS context's extra data that points to the connection pool it belongs to
+static int poolExDataIndex()
+{
+    static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+
+    return index;
+}
+#endif
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+const boost::system::error_category &ctn::timeoutCategory()
+{
+    static const TimeoutCategory category;
+
+    return category;
+}
+
+boost::system::error_code ctn::makeTimeoutError(TimeoutPhase phase)
+{
+    return boost::system::error_code(static_cast<int>(phase), timeoutCategory());
+}
+#endif
+
+// Constructor
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+ctn::CtnApiConnectionPool::CtnApiConnectionPool(boost::asio::io_context &ioc, CtnApiResolver &resolver, std::string host, std::string port, bool secure, const ConnectionPoolOptions &options)
+    : host_(host), port_(port), secure_(secure), options_(options), resolver_(resolver), ioc_(ioc), ssl_ctx_(ssl::context::sslv23_client), tls_session_(nullptr), active_count_(0)
+{
+    if (secure_) {
+        // Have OpenSSL hand over the sessions established by the connections (TLS 1.3 session tickets only arrive
+        //  after the handshake), so they can be resumed by the connections opened later
+        SSL_CTX *ctx = ssl_ctx_.native_handle();
+
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_set_ex_data(ctx, poolExDataIndex(), this);
+        SSL_CTX_sess_set_new_cb(ctx, &CtnApiConnectionPool::storeNewTlsSession);
+    }
+}
+#elif defined(COM_SUPPORT_LIB_POCO)
+ctn::CtnApiConnectionPool::CtnApiConnectionPool(CtnApiResolver &resolver, std::string host, std::string port, bool secure, const ConnectionPoolOptions &options)
+    : host_(host), port_(port), secure_(secure), options_(options), resolver_(resolver), active_count_(0)
+{
+    if (secure_) {
+        ssl_ctx_ = new Poco::Net::Context(Poco::Net::Context::CLIENT_USE, "", Poco::Net::Context::VERIFY_NONE);
+        ssl_ctx_->enableSessionCache(true);
+    }
+}
+#endif
+
+// Destructor
+ctn::CtnApiConnectionPool::~CtnApiConnectionPool()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    idle_.clear();
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    waiters_.clear();
+
+    if (secure_) {
+        SSL_CTX_set_ex_data(ssl_ctx_.native_handle(), poolExDataIndex(), nullptr);
+    }
+
+    if (tls_session_ != nullptr) {
+        SSL_SESSION_free(tls_session_);
+    }
+#endif
+}
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+void ctn::CtnApiConnectionPool::acquireAsync(const RequestTimeouts &timeouts, AcquireHandler handler)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    purgeExpired(std::chrono::steady_clock::now());
+
+    if (!idle_.empty()) {
+        // Most recently used connection is the least likely to have been closed by the server
+        std::unique_ptr<CtnApiConnection> connection = std::move(idle_.back());
+        idle_.pop_back();
+        active_count_++;
+        lock.unlock();
+
+        handler(boost::system::error_code(), std::move(connection));
+        return;
+    }
+
+    if (options_.maxActiveConnections != 0 && active_count_ >= options_.maxActiveConnections) {
+        waiters_.push_back(Waiter(timeouts, handler));
+        return;
+    }
+
+    // Reserve slot and open the new connection
+    active_count_++;
+    lock.unlock();
+
+    openConnectionAsync(timeouts, handler);
+}
+#elif defined(COM_SUPPORT_LIB_POCO)
+std::unique_ptr<ctn::CtnApiConnection> ctn::CtnApiConnectionPool::acquire(std::chrono::steady_clock::time_point deadline)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        purgeExpired(std::chrono::steady_clock::now());
+
+        if (!idle_.empty()) {
+            // Most recently used connection is the least likely to have been closed by the server
+            std::unique_ptr<CtnApiConnection> connection = std::move(idle_.back());
+            idle_.pop_back();
+            active_count_++;
+
+            return connection;
+        }
+
+        if (options_.maxActiveConnections == 0 || active_count_ < options_.maxActiveConnections) {
+            break;
+        }
+
+        if (deadline == std::chrono::steady_clock::time_point::max()) {
+            released_.wait(lock);
+        }
+        else if (released_.wait_until(lock, deadline) == std::cv_status::timeout) {
+            return std::unique_ptr<CtnApiConnection>();
+        }
+    }
+
+    // Reserve slot and open the new connection outside the lock
+    active_count_++;
+    lock.unlock();
+
+    try {
+        return openConnection();
+    }
+    catch (...) {
+        lock.lock();
+        active_count_--;
+        lock.unlock();
+        released_.notify_one();
+
+        throw;
+    }
+}
+#endif
+
+void ctn::CtnApiConnectionPool::release(std::unique_ptr<CtnApiConnection> connection, bool keep_alive)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+#if defined(COM_SUPPORT_LIB_POCO)
+    if (secure_) {
+        // Keep session established (or resumed) by the connection, so it can be resumed by the connections opened later
+        Poco::Net::Session::Ptr tls_session = static_cast<Poco::Net::HTTPSClientSession &>(*connection->session).sslSession();
+
+        if (!tls_session.isNull()) {
+            tls_session_ = tls_session;
+        }
+    }
+#endif
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    if (!waiters_.empty()) {
+        // Hand the connection slot over to the oldest waiting request
+        Waiter waiter = waiters_.front();
+        waiters_.pop_front();
+        lock.unlock();
+
+        if (keep_alive) {
+            connection->reused = true;
+            waiter.handler(boost::system::error_code(), std::move(connection));
+        }
+        else {
+            connection.reset();
+            openConnectionAsync(waiter.timeouts, waiter.handler);
+        }
+
+        return;
+    }
+#endif
+
+    active_count_--;
+
+    if (keep_alive && idle_.size() < options_.maxIdleConnections) {
+        connection->reused = true;
+        connection->lastUsed = std::chrono::steady_clock::now();
+        idle_.push_back(std::move(connection));
+    }
+
+    lock.unlock();
+
+#if defined(COM_SUPPORT_LIB_POCO)
+    released_.notify_one();
+#endif
+
+    // Connection not kept (if any) is closed here, outside the lock
+}
+
+ctn::TlsSessionStats ctn::CtnApiConnectionPool::tlsSessionStats()
+{
+    TlsSessionStats stats;
+
+    if (secure_) {
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+        SSL_CTX *ctx = ssl_ctx_.native_handle();
+#elif defined(COM_SUPPORT_LIB_POCO)
+        SSL_CTX *ctx = ssl_ctx_->sslContext();
+#endif
+
+        // Counters kept by OpenSSL for the TLS context
+        stats.handshakes = SSL_CTX_sess_connect_good(ctx);
+        stats.resumedHandshakes = SSL_CTX_sess_hits(ctx);
+    }
+
+    return stats;
+}
+
+// Drop idle connections that have not been used for longer than the idle timeout
+void ctn::CtnApiConnectionPool::purgeExpired(std::chrono::steady_clock::time_point now)
+{
+    std::chrono::seconds idle_timeout(options_.idleTimeout);
+
+    // Oldest connections are at the front of the list
+    while (!idle_.empty() && now - idle_.front()->lastUsed >= idle_timeout) {
+        idle_.pop_front();
+    }
+}
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+// Called by OpenSSL when a connection has established a new TLS session. Returns 1 to take over the reference to it
+int ctn::CtnApiConnectionPool::storeNewTlsSession(SSL *ssl, SSL_SESSION *session)
+{
+    CtnApiConnectionPool *pool = static_cast<CtnApiConnectionPool *>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), poolExDataIndex()));
+
+    if (pool == nullptr) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(pool->mutex_);
+
+    if (pool->tls_session_ != nullptr) {
+        SSL_SESSION_free(pool->tls_session_);
+    }
+
+    pool->tls_session_ = session;
+
+    return 1;
+}
+
+// Free the slot of a connection that could not be opened, or use it to serve a waiting request
+void ctn::CtnApiConnectionPool::releaseSlot()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (!waiters_.empty()) {
+        Waiter waiter = waiters_.front();
+        waiters_.pop_front();
+        lock.unlock();
+
+        openConnectionAsync(waiter.timeouts, waiter.handler);
+    }
+    else {
+        active_count_--;
+    }
+}
+
+void ctn::CtnApiConnectionPool::openConnectionAsync(const RequestTimeouts &timeouts, AcquireHandler handler)
+{
+    std::shared_ptr<PendingConnection> pending(new PendingConnection(ioc_, handler));
+
+    auto fail = [this, pending](const boost::system::error_code &ec) {
+        this->releaseSlot();
+        pending->handler(ec, std::unique_ptr<CtnApiConnection>());
+    };
+
+    // Get the (cached) addresses of the domain name
+    resolver_.resolveAsync(host_, !port_.empty() ? port_ : (secure_ ? "https" : "http"),
+            [this, pending, fail, timeouts](const boost::system::error_code &ec, std::vector<tcp::endpoint> endpoints) {
+        if (ec) return fail(ec);
+
+        if (secure_) {
+            pending->connection->sslStream.reset(new ssl::stream<tcp::socket>(ioc_, ssl_ctx_));
+
+            // Set SNI Hostname (many hosts need this to handshake successfully)
+            if(! SSL_set_tlsext_host_name(pending->connection->sslStream->native_handle(), host_.c_str()))
+            {
+                return fail(boost::system::error_code(static_cast<int>(::ERR_get_error()), boost::asio::error::get_ssl_category()));
+            }
+
+            // Offer last TLS session for resumption. The server falls back to a full handshake if it cannot resume it
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            if (tls_session_ != nullptr) {
+                SSL_set_session(pending->connection->sslStream->native_handle(), tls_session_);
+            }
+        }
+        else {
+            pending->connection->socket.reset(new tcp::socket(ioc_));
+        }
+
+        // Open the connection, trying each address in turn
+        PendingConnection::startPhase(pending, TimeoutPhase::connect, timeouts.connect);
+
+        boost::asio::async_connect(pending->connection->lowestLayer(), endpoints,
+                [this, pending, fail, timeouts](const boost::system::error_code &ec, const tcp::endpoint &) {
+            pending->endPhase();
+
+            if (pending->timeout) return fail(pending->timeout);
+            if (ec) return fail(ec);
+
+            if (!secure_) {
+                return pending->handler(ec, std::move(pending->connection));
+            }
+
+            // Perform the SSL handshake
+            PendingConnection::startPhase(pending, TimeoutPhase::tlsHandshake, timeouts.tlsHandshake);
+
+            pending->connection->sslStream->set_verify_mode(ssl::verify_none);
+            pending->connection->sslStream->async_handshake(ssl::stream_base::client, [pending, fail](const boost::system::error_code &ec) {
+                pending->endPhase();
+
+                if (pending->timeout) return fail(pending->timeout);
+                if (ec) return fail(ec);
+
+                pending->handler(ec, std::move(pending->connection));
+            });
+        });
+    });
+}
+#elif defined(COM_SUPPORT_LIB_POCO)
+std::unique_ptr<ctn::CtnApiConnection> ctn::CtnApiConnectionPool::openConnection()
+{
+    std::unique_ptr<CtnApiConnection> connection(new CtnApiConnection());
+
+    Poco::UInt16 port = !port_.empty() ? static_cast<Poco::UInt16>(std::stoi(port_)) : (secure_ ? 443 : 80);
+
+    // Session is given the (cached) address of the server, so it does not look up the domain name itself
+    Poco::Net::SocketAddress address = resolver_.resolve(host_, std::to_string(port)).front();
+
+    // Session connects on its first request, and reconnects by itself when the keep-alive timeout elapses
+    if (secure_) {
+        Poco::Net::Session::Ptr tls_session;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tls_session = tls_session_;
+        }
+
+        // Last TLS session is offered for resumption. The domain name is still sent as the SNI hostname
+        Poco::Net::SecureStreamSocket socket(ssl_ctx_, tls_session);
+        socket.setPeerHostName(host_);
+
+        connection->session.reset(new Poco::Net::HTTPSClientSession(socket, tls_session));
+        connection->session->setHost(address.host().toString());
+        connection->session->setPort(address.port());
+    }
+    else {
+        connection->session.reset(new Poco::Net::HTTPClientSession(address));
+    }
+
+    connection->session->setKeepAlive(true);
+    connection->session->setKeepAliveTimeout(Poco::Timespan(options_.idleTimeout, 0));
+
+    return connection;
+}
+#endif
@@ -0,0 +1,45 @@
+//
+//  CatenisApiDeviceTable.cpp
+//  CatenisAPIClientCpp
+//
+
+#include <algorithm>
+
+#include <CatenisApiDeviceTable.h>
+
+static const std::size_t MIN_PURGE_SIZE = 1024;
+
+// Constructor
+ctn::CtnApiDeviceTable::CtnApiDeviceTable() : purge_size_(MIN_PURGE_SIZE) {}
+
+void ctn::CtnApiDeviceTable::intern(std::shared_ptr<DeviceInfo> &device)
+{
+    if (!device) return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::weak_ptr<DeviceInfo> &entry = devices_[device->deviceId];
+    std::shared_ptr<DeviceInfo> shared = entry.lock();
+
+    if (shared == device) return;
+
+    if (shared && shared->name == device->name && shared->prodUniqueId == device->prodUniqueId) {
+        device = shared;
+        return;
+    }
+
+    // New device, or device whose name or product unique ID has changed. Results that refer to the previous one keep it
+    entry = device;
+
+    if (devices_.size() >= purge_size_) purge();
+}
+
+// Remove the entries of the devices no longer referred to
+void ctn::CtnApiDeviceTable::purge()
+{
+    for (auto it = devices_.begin(); it != devices_.end();) {
+        if (it->second.expired()) it = devices_.erase(it);
+        else ++it;
+    }
+
+    purge_size_ = std::max(MIN_PURGE_SIZE, devices_.size() * 2);
+}
@@ -0,0 +1,72 @@
+//
+//  CatenisApiDigest.cpp
+//  CatenisAPIClientCpp
+//
+
+#include <string>
+
+#include <openssl/evp.h>
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+#define EVP_MD_CTX_new EVP_MD_CTX_create
+#define EVP_MD_CTX_free EVP_MD_CTX_destroy
+#endif
+
+#include <CatenisApiException.h>
+#include <CatenisApiDigest.h>
+#include <CatenisApiUtils.h>
+
+// Constructor
+ctn::CtnApiSha256::CtnApiSha256()
+    : ctx_(EVP_MD_CTX_new())
+{
+    if (this->ctx_ == NULL || EVP_DigestInit_ex(this->ctx_, EVP_sha256(), NULL) != 1) {
+        EVP_MD_CTX_free(this->ctx_);
+        throw CatenisClientError("Error initializing SHA-256 digest");
+    }
+}
+
+// Copy constructor
+ctn::CtnApiSha256::CtnApiSha256(const CtnApiSha256 &other)
+    : ctx_(EVP_MD_CTX_new())
+{
+    if (this->ctx_ == NULL || EVP_MD_CTX_copy_ex(this->ctx_, other.ctx_) != 1) {
+        EVP_MD_CTX_free(this->ctx_);
+        throw CatenisClientError("Error copying SHA-256 digest");
+    }
+}
+
+// Destructor
+ctn::CtnApiSha256::~CtnApiSha256()
+{
+    EVP_MD_CTX_free(this->ctx_);
+}
+
+ctn::CtnApiSha256 &ctn::CtnApiSha256::update(const char *data, std::size_t size)
+{
+    if (EVP_DigestUpdate(this->ctx_, data, size) != 1) {
+        throw CatenisClientError("Error computing SHA-256 digest");
+    }
+
+    return *this;
+}
+
+void ctn::CtnApiSha256::hexDigest(char *out)
+{
+    unsigned char hash[EVP_MAX_MD_SIZE];
+    unsigned int len;
+
+    if (EVP_DigestFinal_ex(this->ctx_, hash, &len) != 1) {
+        throw CatenisClientError("Error computing SHA-256 digest");
+    }
+
+    hexEncode(hash, len, out);
+}
+
+std::string ctn::CtnApiSha256::hexDigest()
+{
+    char hex_hash[SHA256_HEX_LENGTH];
+    hexDigest(hex_hash);
+
+    return std::string(hex_hash, sizeof hex_hash);
+}
@@ -0,0 +1,501 @@
+//
+//  CatenisApiDiskCache.cpp
+//  CatenisAPIClientCpp
+//
+
+#include <cstring>
+#include <memory>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include <CatenisApiDiskCache.h>
+#include <CatenisApiException.h>
+
+// File layout: header, hash index buckets, then the records, each one aligned to 8 bytes
+static const char FILE_MAGIC[8] = {'C', 'T', 'N', 'C', 'A', 'C', 'H', 'E'};
+static const std::uint32_t FILE_VERSION = 2;
+static const std::uint32_t BUCKET_COUNT = 16384;
+static const std::uint64_t HEADER_SIZE = 64;
+static const std::uint64_t DATA_START = HEADER_SIZE + BUCKET_COUNT * sizeof(std::uint64_t);
+static const std::uint64_t INITIAL_SIZE = DATA_START + 1024 * 1024;
+
+// Kinds of record
+static const std::uint32_t KIND_MESSAGE = 1;
+static const std::uint32_t KIND_CONTAINER = 2;
+
+/*
+ * File header
+ *
+ * @member dataEnd : Offset past the last record, where the next one is appended
+ * @member ownerHash : Hash of the device and API server whose results are kept
+ */
+struct FileHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t bucketCount;
+    std::uint64_t dataEnd;
+    std::uint64_t recordCount;
+    std::uint64_t ownerHash;
+};
+
+/*
+ * Record header. It is followed by the key, and then the value
+ *
+ * @member next : Offset of the previous record of the same bucket (0: none)
+ */
+struct RecordHeader
+{
+    std::uint64_t next;
+    std::uint32_t hash;
+    std::uint32_t kind;
+    std::uint32_t keySize;
+    std::uint32_t valueSize;
+};
+
+// FNV-1a hash of the key
+static std::uint32_t hashKey(std::uint32_t kind, const std::string &key)
+{
+    std::uint32_t hash = 2166136261u ^ kind;
+
+    for (unsigned char c : key) {
+        hash = (hash ^ c) * 16777619u;
+    }
+
+    return hash;
+}
+
+// FNV-1a hash of the owner of the file
+static std::uint64_t hashOwner(const std::string &owner)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+
+    for (unsigned char c : owner) {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+
+    return hash;
+}
+
+static std::uint64_t alignedSize(std::uint64_t size)
+{
+    return (size + 7) & ~static_cast<std::uint64_t>(7);
+}
+
+// Fields of a value: strings are prefixed by their length, and flags take one byte
+
+static void writeString(std::string &out, const std::string &str)
+{
+    std::uint32_t size = static_cast<std::uint32_t>(str.size());
+
+    out.append(reinterpret_cast<const char *>(&size), sizeof(size));
+    out.append(str);
+}
+
+static void writeFlag(std::string &out, bool flag)
+{
+    out += flag ? '\1' : '\0';
+}
+
+// Reads the fields of a value straight from the mapped file
+class ValueReader
+{
+public:
+    ValueReader(const char *value, std::uint32_t size) : pos_(value), end_(value + size) {}
+
+    bool read(std::string &str)
+    {
+        std::uint32_t size;
+
+        if (end_ - pos_ < static_cast<std::ptrdiff_t>(sizeof(size))) return false;
+
+        std::memcpy(&size, pos_, sizeof(size));
+        pos_ += sizeof(size);
+
+        if (static_cast<std::size_t>(end_ - pos_) < size) return false;
+
+        str.assign(pos_, size);
+        pos_ += size;
+
+        return true;
+    }
+
+    bool read(bool &flag)
+    {
+        if (pos_ == end_) return false;
+
+        flag = *pos_++ != '\0';
+
+        return true;
+    }
+
+    bool read(std::uint32_t &number)
+    {
+        if (end_ - pos_ < static_cast<std::ptrdiff_t>(sizeof(number))) return false;
+
+        std::memcpy(&number, pos_, sizeof(number));
+        pos_ += sizeof(number);
+
+        return true;
+    }
+
+private:
+    const char *pos_;
+    const char *end_;
+};
+
+// Constructor
+ctn::CtnApiDiskCache::CtnApiDiskCache(std::string path, std::uint64_t max_size, const std::string &owner)
+    : path_(path), max_size_(std::max(max_size, INITIAL_SIZE)), owner_hash_(hashOwner(owner)),
+#ifdef _WIN32
+    file_(INVALID_HANDLE_VALUE), mapping_(nullptr),
+#else
+    fd_(-1),
+#endif
+    base_(nullptr), mapped_size_(0), hits_(0)
+{
+    open();
+}
+
+// Destructor
+ctn::CtnApiDiskCache::~CtnApiDiskCache()
+{
+    close();
+}
+
+void ctn::CtnApiDiskCache::open()
+{
+    std::uint64_t file_size;
+
+#ifdef _WIN32
+    file_ = CreateFileA(path_.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    LARGE_INTEGER size;
+
+    if (file_ == INVALID_HANDLE_VALUE || !GetFileSizeEx(file_, &size)) {
+        close();
+        throw CatenisClientError("Unable to open persistent cache file: " + path_);
+    }
+
+    file_size = static_cast<std::uint64_t>(size.QuadPart);
+#else
+    struct stat st;
+
+    fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT, 0600);
+
+    if (fd_ < 0 || fstat(fd_, &st) != 0) {
+        close();
+        throw CatenisClientError("Unable to open persistent cache file: " + path_);
+    }
+
+    file_size = static_cast<std::uint64_t>(st.st_size);
+#endif
+
+    if (file_size >= INITIAL_SIZE && map(file_size) && isValid()) return;
+
+    // New or unusable file, or one kept for another device or API server: start over
+    if (!map(INITIAL_SIZE)) {
+        close();
+        throw CatenisClientError("Unable to map persistent cache file: " + path_);
+    }
+
+    initialize();
+}
+
+void ctn::CtnApiDiskCache::close()
+{
+    unmap();
+
+#ifdef _WIN32
+    if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+    file_ = INVALID_HANDLE_VALUE;
+#else
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+#endif
+}
+
+// Map the file, after growing it to the given size if needed
+bool ctn::CtnApiDiskCache::map(std::uint64_t size)
+{
+    unmap();
+
+#ifdef _WIN32
+    LARGE_INTEGER file_size;
+
+    if (!GetFileSizeEx(file_, &file_size)) return false;
+
+    if (static_cast<std::uint64_t>(file_size.QuadPart) < size) {
+        LARGE_INTEGER new_size;
+        new_size.QuadPart = static_cast<LONGLONG>(size);
+
+        if (!SetFilePointerEx(file_, new_size, nullptr, FILE_BEGIN) || !SetEndOfFile(file_)) return false;
+    }
+
+    mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32), static_cast<DWORD>(size), nullptr);
+
+    if (mapping_ == nullptr) return false;
+
+    base_ = static_cast<char *>(MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS, 0, 0, static_cast<SIZE_T>(size)));
+
+    if (base_ == nullptr) {
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+        return false;
+    }
+#else
+    struct stat st;
+
+    if (fstat(fd_, &st) != 0) return false;
+
+    if (static_cast<std::uint64_t>(st.st_size) < size && ftruncate(fd_, static_cast<off_t>(size)) != 0) return false;
+
+    void *base = mmap(nullptr, static_cast<std::size_t>(size), PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+
+    if (base == MAP_FAILED) return false;
+
+    base_ = static_cast<char *>(base);
+#endif
+
+    mapped_size_ = size;
+
+    return true;
+}
+
+void ctn::CtnApiDiskCache::unmap()
+{
+    if (base_ == nullptr) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(base_);
+    CloseHandle(mapping_);
+    mapping_ = nullptr;
+#else
+    munmap(base_, static_cast<std::size_t>(mapped_size_));
+#endif
+
+    base_ = nullptr;
+    mapped_size_ = 0;
+}
+
+void ctn::CtnApiDiskCache::initialize()
+{
+    std::memset(base_, 0, static_cast<std::size_t>(DATA_START));
+
+    FileHeader *header = reinterpret_cast<FileHeader *>(base_);
+
+    std::memcpy(header->magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header->version = FILE_VERSION;
+    header->bucketCount = BUCKET_COUNT;
+    header->dataEnd = DATA_START;
+    header->recordCount = 0;
+    header->ownerHash = owner_hash_;
+}
+
+bool ctn::CtnApiDiskCache::isValid() const
+{
+    const FileHeader *header = reinterpret_cast<const FileHeader *>(base_);
+
+    return std::memcmp(header->magic, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0 && header->version == FILE_VERSION
+            && header->bucketCount == BUCKET_COUNT && header->dataEnd >= DATA_START && header->dataEnd <= mapped_size_ && header->ownerHash == owner_hash_;
+}
+
+// Make room for appending a record of the given size. Returns false if the file would exceed its maximum size
+bool ctn::CtnApiDiskCache::reserve(std::uint64_t size)
+{
+    std::uint64_t needed = reinterpret_cast<const FileHeader *>(base_)->dataEnd + size;
+    std::uint64_t current_size = mapped_size_;
+
+    if (needed <= current_size) return true;
+    if (needed > max_size_) return false;
+
+    if (map(std::min(std::max(current_size * 2, needed), max_size_))) return true;
+
+    // Keep using the file at its current size
+    map(current_size);
+
+    return false;
+}
+
+// Locate the value of the newest record of the key. The mutex must be held while the value is used
+bool ctn::CtnApiDiskCache::find(std::uint32_t kind, const std::string &key, const char *&value, std::uint32_t &value_size)
+{
+    std::uint32_t hash = hashKey(kind, key);
+
+    if (base_ == nullptr) return false;
+
+    const std::uint64_t *buckets = reinterpret_cast<const std::uint64_t *>(base_ + HEADER_SIZE);
+    std::uint64_t data_end = reinterpret_cast<const FileHeader *>(base_)->dataEnd;
+
+    // Newest record of a key comes first
+    for (std::uint64_t offset = buckets[hash % BUCKET_COUNT]; offset != 0; ) {
+        if (offset < DATA_START || offset + sizeof(RecordHeader) > data_end) return false;
+
+        const RecordHeader *record = reinterpret_cast<const RecordHeader *>(base_ + offset);
+        const char *record_key = base_ + offset + sizeof(RecordHeader);
+
+        if (offset + sizeof(RecordHeader) + record->keySize + record->valueSize > data_end) return false;
+
+        if (record->hash == hash && record->kind == kind && record->keySize == key.size()
+                && std::memcmp(record_key, key.data(), key.size()) == 0) {
+            value = record_key + record->keySize;
+            value_size = record->valueSize;
+
+            return true;
+        }
+
+        // Records are only ever appended, so a record can only be linked to an older one. Otherwise, the file is corrupted
+        if (record->next >= offset) return false;
+
+        offset = record->next;
+    }
+
+    return false;
+}
+
+void ctn::CtnApiDiskCache::append(std::uint32_t kind, const std::string &key, const std::string &value)
+{
+    std::uint32_t hash = hashKey(kind, key);
+    std::uint64_t size = alignedSize(sizeof(RecordHeader) + key.size() + value.size());
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (base_ == nullptr || !reserve(size)) return;
+
+    FileHeader *header = reinterpret_cast<FileHeader *>(base_);
+    std::uint64_t *bucket = reinterpret_cast<std::uint64_t *>(base_ + HEADER_SIZE) + hash % BUCKET_COUNT;
+    std::uint64_t offset = header->dataEnd;
+    RecordHeader *record = reinterpret_cast<RecordHeader *>(base_ + offset);
+
+    record->next = *bucket;
+    record->hash = hash;
+    record->kind = kind;
+    record->keySize = static_cast<std::uint32_t>(key.size());
+    record->valueSize = static_cast<std::uint32_t>(value.size());
+    std::memcpy(base_ + offset + sizeof(RecordHeader), key.data(), key.size());
+    std::memcpy(base_ + offset + sizeof(RecordHeader) + key.size(), value.data(), value.size());
+
+    // Record is only linked in once it is complete
+    header->dataEnd = offset + size;
+    header->recordCount++;
+    *bucket = offset;
+}
+
+bool ctn::CtnApiDiskCache::load(const std::string &key, ReadMessageResult &data)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const char *value;
+    std::uint32_t value_size;
+
+    if (!find(KIND_MESSAGE, key, value, value_size)) return false;
+
+    ValueReader reader(value, value_size);
+    ReadMessageResult result;
+    bool has_from;
+
+    if (!reader.read(result.action) || !reader.read(result.message) || !reader.read(has_from)) return false;
+
+    if (has_from) {
+        std::string device_id, name, prod_unique_id;
+
+        if (!reader.read(device_id) || !reader.read(name) || !reader.read(prod_unique_id)) return false;
+
+        result.from = std::make_shared<DeviceInfo>(device_id, name, prod_unique_id);
+    }
+
+    data = std::move(result);
+    hits_++;
+
+    return true;
+}
+
+bool ctn::CtnApiDiskCache::load(const std::string &key, RetrieveMessageContainerResult &data)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const char *value;
+    std::uint32_t value_size;
+
+    if (!find(KIND_CONTAINER, key, value, value_size)) return false;
+
+    ValueReader reader(value, value_size);
+    RetrieveMessageContainerResult result;
+    bool has_external_storage;
+
+    if (!reader.read(result.blockchain.txid) || !reader.read(result.blockchain.isConfirmed) || !reader.read(has_external_storage)) {
+        return false;
+    }
+
+    if (has_external_storage) {
+        std::uint32_t count;
+
+        if (!reader.read(count)) return false;
+
+        result.externalStorage = std::make_shared<StorageProviderDictionary>();
+
+        for (std::uint32_t idx = 0; idx < count; idx++) {
+            std::string provider, reference;
+
+            if (!reader.read(provider) || !reader.read(reference)) return false;
+
+            (*result.externalStorage)[provider] = reference;
+        }
+    }
+
+    data = std::move(result);
+    hits_++;
+
+    return true;
+}
+
+void ctn::CtnApiDiskCache::save(const std::string &key, const ReadMessageResult &data)
+{
+    std::string value;
+
+    writeString(value, data.action);
+    writeString(value, data.message);
+    writeFlag(value, static_cast<bool>(data.from));
+
+    if (data.from) {
+        writeString(value, data.from->deviceId);
+        writeString(value, data.from->name);
+        writeString(value, data.from->prodUniqueId);
+    }
+
+    append(KIND_MESSAGE, key, value);
+}
+
+void ctn::CtnApiDiskCache::save(const std::string &key, const RetrieveMessageContainerResult &data)
+{
+    std::string value;
+
+    writeString(value, data.blockchain.txid);
+    writeFlag(value, data.blockchain.isConfirmed);
+    writeFlag(value, static_cast<bool>(data.externalStorage));
+
+    if (data.externalStorage) {
+        std::uint32_t count = static_cast<std::uint32_t>(data.externalStorage->size());
+
+        value.append(reinterpret_cast<const char *>(&count), sizeof(count));
+
+        for (auto const &entry : *data.externalStorage) {
+            writeString(value, entry.first);
+            writeString(value, entry.second);
+        }
+    }
+
+    append(KIND_CONTAINER, key, value);
+}
+
+unsigned long ctn::CtnApiDiskCache::hits()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    return hits_;
+}
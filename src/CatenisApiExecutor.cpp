@@ -0,0 +1,151 @@
+//
+//  CatenisApiExecutor.cpp
+//  CatenisAPIClientCpp
+//
+
+#include <memory>
+#include <utility>
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#endif
+
+#include <CatenisApiExecutor.h>
+
+// Constructor
+ctn::CtnApiExecutor::CtnApiExecutor(unsigned int num_threads)
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    : work_(boost::asio::make_work_guard(ioc_))
+#elif defined(COM_SUPPORT_LIB_POCO)
+    : stopping_(false)
+#endif
+{
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    // A single I/O thread drives all requests, so no handler ever runs concurrently with another one. Responses of
+    //  synchronous calls are parsed by the threads that made them instead
+    num_threads = 1;
+#endif
+    if (num_threads == 0) num_threads = 1;
+
+    for (unsigned int idx = 0; idx < num_threads; idx++) {
+        threads_.push_back(std::thread(&CtnApiExecutor::run, this));
+    }
+}
+
+// Destructor
+ctn::CtnApiExecutor::~CtnApiExecutor()
+{
+    stop();
+}
+
+void ctn::CtnApiExecutor::stop()
+{
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    work_.reset();
+    ioc_.stop();
+#elif defined(COM_SUPPORT_LIB_POCO)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wakeup_.notify_all();
+#endif
+
+    for (auto &thread : threads_) {
+        if (thread.joinable() && thread.get_id() != std::this_thread::get_id()) {
+            thread.join();
+        }
+    }
+
+#if defined(COM_SUPPORT_LIB_POCO)
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.clear();
+    delayed_tasks_.clear();
+#endif
+}
+
+void ctn::CtnApiExecutor::post(std::function<void()> task)
+{
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    boost::asio::post(ioc_, task);
+#elif defined(COM_SUPPORT_LIB_POCO)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(task);
+    }
+    wakeup_.notify_one();
+#endif
+}
+
+void ctn::CtnApiExecutor::postAfter(std::chrono::milliseconds delay, std::function<void()> task)
+{
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    std::shared_ptr<boost::asio::steady_timer> timer(new boost::asio::steady_timer(ioc_, delay));
+
+    timer->async_wait([timer, task](const boost::system::error_code &ec) {
+        if (!ec) task();
+    });
+#elif defined(COM_SUPPORT_LIB_POCO)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        delayed_tasks_.insert(std::make_pair(std::chrono::steady_clock::now() + delay, task));
+    }
+    wakeup_.notify_one();
+#endif
+}
+
+bool ctn::CtnApiExecutor::runningInThisThread() const
+{
+    for (auto const &thread : threads_) {
+        if (thread.get_id() == std::this_thread::get_id()) return true;
+    }
+
+    return false;
+}
+
+// Thread body
+void ctn::CtnApiExecutor::run()
+{
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    while (!ioc_.stopped()) {
+        try {
+            ioc_.run();
+        }
+        catch (...) {
+            // A completion callback has thrown. Keep the loop running for the other requests
+        }
+    }
+#elif defined(COM_SUPPORT_LIB_POCO)
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (!stopping_) {
+        // Move delayed tasks that are due to the run queue
+        auto now = std::chrono::steady_clock::now();
+
+        while (!delayed_tasks_.empty() && delayed_tasks_.begin()->first <= now) {
+            tasks_.push_back(std::move(delayed_tasks_.begin()->second));
+            delayed_tasks_.erase(delayed_tasks_.begin());
+        }
+
+        if (tasks_.empty()) {
+            if (delayed_tasks_.empty()) wakeup_.wait(lock);
+            else wakeup_.wait_until(lock, delayed_tasks_.begin()->first);
+            continue;
+        }
+
+        std::function<void()> task = std::move(tasks_.front());
+        tasks_.pop_front();
+        lock.unlock();
+
+        try {
+            task();
+        }
+        catch (...) {
+            // A completion callback has thrown. Keep the worker running for the other requests
+        }
+
+        lock.lock();
+    }
+#endif
+}
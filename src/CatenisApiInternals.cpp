@@ -17,30 +17,31 @@
 #include <iomanip>
 #include <list>
 #include <memory>
-
-#include <openssl/sha.h>
-#include <openssl/hmac.h>
-#include <openssl/evp.h>
+#include <chrono>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <unordered_set>
+#include <unordered_map>
 
 #if defined(COM_SUPPORT_LIB_BOOST_ASIO)
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
 #include <boost/beast/version.hpp>
 #include <boost/asio/connect.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/ssl/error.hpp>
 #include <boost/asio/ssl/stream.hpp>
 /*#include <boost/asio.hpp>
 #include <boost/asio/ssl.hpp>*/
 #include <json-spirit/json_spirit_reader_template.h>
-#include <json-spirit/json_spirit_writer_template.h>
 
 using boost::asio::ip::tcp;
 namespace http = boost::beast::http;
 namespace ssl = boost::asio::ssl;
 #elif defined(COM_SUPPORT_LIB_POCO)
 #include <Poco/JSON/Object.h>
-#include <Poco/JSON/Stringifier.h>
 #include <Poco/JSON/Parser.h>
 #include <Poco/Dynamic/Var.h>
 #include <Poco/JSON/Object.h>
@@ -52,373 +53,2127 @@ namespace ssl = boost::asio::ssl;
 #include <Poco/Path.h>
 #include <Poco/URI.h>
 #include <Poco/Exception.h>
+#include <Poco/Timespan.h>
 #include <Poco/Net/HTTPSClientSession.h>
 #include <Poco/Net/Context.h>
+#include <Poco/Net/NetException.h>
+#include <Poco/Net/SSLException.h>
 #endif
 
 #include <CatenisApiException.h>
 #include <CatenisApiInternals.h>
+#include <CatenisApiConnectionPool.h>
+#include <CatenisApiExecutor.h>
+#include <CatenisApiResolver.h>
+#include <CatenisApiDeviceTable.h>
+#include <CatenisApiScheduler.h>
+#include <CatenisApiSigningKey.h>
+#include <CatenisApiDigest.h>
+#include <CatenisApiJsonReader.h>
+#include <CatenisApiUtils.h>
 
-// http request
 #if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-void ctn::CtnApiInternals::httpRequest(std::string verb, std::string methodpath, std::map<std::string, std::string> &params, std::map<std::string, std::string> &queries, json_spirit::mValue const &request_data, std::string &response_data)
-#elif defined(COM_SUPPORT_LIB_POCO)
-void ctn::CtnApiInternals::httpRequest(std::string verb, std::string methodpath, std::map<std::string, std::string> &params, std::map<std::string, std::string> &queries, Poco::JSON::Object &request_data, std::string &response_data)
+// Parse JSON into a document tree. The json_spirit parser cannot be used from several threads at once (unless built
+//  with BOOST_SPIRIT_THREADSAFE, which requires the Boost Thread library), so parsing is serialized
+static void readJsonTree(const std::string &json_data, json_spirit::mValue &result)
+{
+    static std::mutex json_spirit_mutex;
+    std::lock_guard<std::mutex> lock(json_spirit_mutex);
+
+    json_spirit::read_string_or_throw(json_data, result);
+}
+
+// Errors indicating that a reused keep-alive connection had been closed by the server
+static bool isStaleConnectionError(const boost::system::error_code &ec)
+{
+    return ec == http::error::end_of_stream || ec == boost::asio::error::eof || ec == boost::asio::error::connection_reset
+            || ec == boost::asio::error::connection_aborted || ec == boost::asio::error::broken_pipe
+            || ec == ssl::error::stream_errors::stream_truncated;
+}
+
+namespace
+{
+
+// Asynchronous HTTP request/response exchange over a pooled connection. Runs on the executor's I/O thread
+//
+// Sending the request and receiving the response are each given their own time. When it runs out, or when the deadline
+//  of the whole exchange is reached, the connection is closed so its pending operation completes, and the timeout is
+//  reported instead of the error of that operation
+class HttpExchange : public std::enable_shared_from_this<HttpExchange>
+{
+public:
+    typedef std::function<void(const boost::system::error_code &ec, http::response<http::string_body> &res)> CompletionHandler;
+
+    HttpExchange(boost::asio::io_context &ioc, ctn::CtnApiConnectionPool &pool, std::shared_ptr<const ctn::RequestTimeouts> timeouts,
+            std::chrono::steady_clock::time_point deadline, CompletionHandler handler)
+        : pool_(pool), timeouts_(timeouts), deadline_(deadline), handler_(handler), phase_timer_(ioc), deadline_timer_(ioc), phase_(0), reused_(false), done_(false) {}
+
+    http::request<http::string_body> &request() { return req_; }
+
+    void start()
+    {
+        if (deadline_ != std::chrono::steady_clock::time_point::max()) {
+            std::shared_ptr<HttpExchange> self = shared_from_this();
+
+            deadline_timer_.expires_at(deadline_);
+            deadline_timer_.async_wait([self](const boost::system::error_code &ec) {
+                if (!ec) self->onDeadline();
+            });
+        }
+
+        acquire();
+    }
+
+private:
+    ctn::CtnApiConnectionPool &pool_;
+    std::shared_ptr<const ctn::RequestTimeouts> timeouts_;
+    // Deadline of the request, shared by all its attempts
+    std::chrono::steady_clock::time_point deadline_;
+    CompletionHandler handler_;
+    http::request<http::string_body> req_;
+    http::response<http::string_body> res_;
+    std::unique_ptr<ctn::CtnApiConnection> connection_;
+    boost::asio::steady_timer phase_timer_;
+    boost::asio::steady_timer deadline_timer_;
+    // Phase being timed, if any. The timer's handler checks it, since it may already be queued when the phase completes
+    int phase_;
+    boost::system::error_code timeout_;
+    bool reused_;
+    bool done_;
+
+    void acquire()
+    {
+        std::shared_ptr<HttpExchange> self = shared_from_this();
+
+        pool_.acquireAsync(*timeouts_, [self](const boost::system::error_code &ec, std::unique_ptr<ctn::CtnApiConnection> connection) {
+            self->onConnection(ec, std::move(connection));
+        });
+    }
+
+    void onConnection(const boost::system::error_code &ec, std::unique_ptr<ctn::CtnApiConnection> connection)
+    {
+        if (done_) {
+            // Deadline reached while waiting for the connection. Leave it for other requests
+            if (!ec) pool_.release(std::move(connection), true);
+            return;
+        }
+
+        if (ec) return finish(ec);
+
+        connection_ = std::move(connection);
+        reused_ = connection_->reused;
+
+        // Send the HTTP request
+        std::shared_ptr<HttpExchange> self = shared_from_this();
+        auto on_write = [self](const boost::system::error_code &ec, std::size_t) {
+            self->onWrite(ec);
+        };
+
+        startPhase(ctn::TimeoutPhase::send, timeouts_->send);
+
+        if (connection_->sslStream) http::async_write(*connection_->sslStream, req_, on_write);
+        else http::async_write(*connection_->socket, req_, on_write);
+    }
+
+    void onWrite(const boost::system::error_code &ec)
+    {
+        endPhase();
+
+        if (ec || timeout_) return onError(ec, false);
+
+        // Receive the HTTP response
+        std::shared_ptr<HttpExchange> self = shared_from_this();
+        auto on_read = [self](const boost::system::error_code &ec, std::size_t) {
+            self->onRead(ec);
+        };
+
+        res_ = http::response<http::string_body>();
+
+        startPhase(ctn::TimeoutPhase::receive, timeouts_->receive);
+
+        if (connection_->sslStream) http::async_read(*connection_->sslStream, connection_->buffer, res_, on_read);
+        else http::async_read(*connection_->socket, connection_->buffer, res_, on_read);
+    }
+
+    void onRead(const boost::system::error_code &ec)
+    {
+        endPhase();
+
+        if (ec || timeout_) return onError(ec, true);
+
+        pool_.release(std::move(connection_), res_.keep_alive());
+        finish(ec);
+    }
+
+    // Request is only sent again over another connection if the server cannot have processed it: either it was not
+    //  completely sent, or it does not change any state
+    void onError(const boost::system::error_code &ec, bool request_sent)
+    {
+        pool_.release(std::move(connection_), false);
+
+        if (timeout_) return finish(timeout_);
+
+        // Server may have closed an idle connection: retry it over another one
+        if (reused_ && isStaleConnectionError(ec) && (!request_sent || req_.method() == http::verb::get)) return acquire();
+
+        finish(ec);
+    }
+
+    void onDeadline()
+    {
+        if (done_ || timeout_) return;
+
+        timeout_ = ctn::makeTimeoutError(ctn::TimeoutPhase::deadline);
+
+        // Pending operation on the connection completes with an error, which is reported as the timeout
+        if (connection_) return closeConnection();
+
+        // Still waiting for a connection
+        finish(timeout_);
+    }
+
+    // Close the connection if the phase does not complete within the given time (0: no limit)
+    void startPhase(ctn::TimeoutPhase phase, unsigned int timeout)
+    {
+        phase_ = static_cast<int>(phase);
+
+        if (timeout == 0) return;
+
+        std::shared_ptr<HttpExchange> self = shared_from_this();
+
+        phase_timer_.expires_after(std::chrono::milliseconds(timeout));
+        phase_timer_.async_wait([self, phase](const boost::system::error_code &ec) {
+            if (ec || self->phase_ != static_cast<int>(phase) || self->timeout_) return;
+
+            self->timeout_ = ctn::makeTimeoutError(phase);
+            self->closeConnection();
+        });
+    }
+
+    void endPhase()
+    {
+        phase_ = 0;
+        phase_timer_.cancel();
+    }
+
+    void closeConnection()
+    {
+        boost::system::error_code ignored;
+        connection_->lowestLayer().close(ignored);
+    }
+
+    void finish(const boost::system::error_code &ec)
+    {
+        done_ = true;
+        deadline_timer_.cancel();
+
+        handler_(ec, res_);
+    }
+};
+
+}
 #endif
+
+// Start the deadline of the request, unless it has already been started
+static void startDeadline(ctn::ApiRequest &request)
+{
+    if (request.deadline == std::chrono::steady_clock::time_point::max() && request.timeouts->deadline > 0) {
+        request.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(request.timeouts->deadline);
+    }
+}
+
+// Indicates whether a retry of the request, after the given delay, would start before its deadline
+static bool retryWithinDeadline(const ctn::ApiRequest &request, std::chrono::milliseconds delay)
+{
+    return request.deadline == std::chrono::steady_clock::time_point::max() || std::chrono::steady_clock::now() + delay < request.deadline;
+}
+
+// Assemble complete path and signed headers of request
+void ctn::CtnApiInternals::prepareRequest(ApiRequest &request, std::string &methodpath, std::map<std::string, std::string> &headers)
 {
     // Assemble complete path
-    methodpath = this->root_api_endpoint_ + "/" + methodpath;
+    methodpath = this->root_api_endpoint_ + "/" + request.methodpath;
 
     // Add path parameters if required
-    for(auto const &data : params)
+    for(auto const &data : request.params)
     {
         methodpath.replace(methodpath.find(data.first), data.first.length(), data.second);
     }
 
     // Add query string if required
-    for(auto const &data : queries)
+    for(auto const &data : request.queries)
     {
         // if not first query add "&", else add "?"
-        if(data != *queries.begin()) methodpath += "&";
+        if(data != *request.queries.begin()) methodpath += "&";
         else methodpath += "?";
         methodpath += data.first + "=" + data.second;
     }
 
-    // Add request payload if required
-    std::string payload_json;
-
-    if(verb == "POST")
-    {
-        std::ostringstream payload_buf;
-#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-        payload_json = json_spirit::write_string(request_data, json_spirit::Output_options::raw_utf8);
-#elif defined(COM_SUPPORT_LIB_POCO)
-        Poco::JSON::Stringifier::stringify(request_data, payload_buf);
-        payload_json = payload_buf.str();
-#endif
-    }
-
     // Create necessary headers
     time_t now = std::time(0);
     char iso_time[17];
-    strftime(iso_time, sizeof iso_time, "%Y%m%dT%H%M%SZ", gmtime(&now));
-    std::map<std::string, std::string> headers;
-    
+    struct tm now_tm;
+#ifdef _WIN32
+    gmtime_s(&now_tm, &now);
+#else
+    gmtime_r(&now, &now_tm);
+#endif
+    strftime(iso_time, sizeof iso_time, "%Y%m%dT%H%M%SZ", &now_tm);
+
     headers["host"] = this->host_;
     headers[TIME_STAMP_HDR] = std::string(iso_time);
-    
+
     // Create signature and add to header
-    signRequest(verb, methodpath, headers, payload_json, now);
+    // Hash payload in place, unless it has already been hashed while it was assembled
+    if (request.payloadHash.empty()) {
+        request.payloadHash = CtnApiSha256().update(request.payload).hexDigest();
+    }
+
+    signRequest(request.verb, methodpath, headers, request.payloadHash, now);
+}
+
+// Timeouts in effect for the API method calls issued by the calling thread
+std::shared_ptr<const ctn::RequestTimeouts> ctn::CtnApiInternals::currentTimeouts() const
+{
+    const RequestTimeoutsOverride *timeouts_override = RequestTimeoutsOverride::current();
+
+    if (timeouts_override != nullptr) {
+        return std::make_shared<const RequestTimeouts>(timeouts_override->timeouts());
+    }
+
+    return this->timeouts_;
+}
+
+void ctn::CtnApiInternals::checkBlockingCallAllowed()
+{
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    // Waiting here would block the I/O thread that should complete the request
+    if (this->executor_->runningInThisThread()) {
+        throw CatenisClientError("Synchronous API method cannot be called from an asynchronous API method callback");
+    }
+#endif
+}
+
+// Key identifying GET requests that get the same response. Concurrent requests with the same key share a single
+//  request to the server
+std::string ctn::CtnApiInternals::inflightRequestKey(const ApiRequest &request)
+{
+    std::string key = request.methodpath;
+
+    for (auto const &param : request.params) {
+        key += "\n" + param.first + "=" + param.second;
+    }
+
+    key += "\n?";
+
+    for (auto const &query : request.queries) {
+        key += "\n" + query.first + "=" + query.second;
+    }
+
+    return key;
+}
+
+// Wait for the request with the given key, if one is in progress. Otherwise, record that it is about to be issued, and
+//  return false
+bool ctn::CtnApiInternals::joinInflightRequest(const std::string &key, HttpCallback callback)
+{
+    std::lock_guard<std::mutex> lock(this->inflight_mutex_);
+    auto it = this->inflight_requests_.find(key);
 
+    if (it == this->inflight_requests_.end()) {
+        this->inflight_requests_[key];
+        return false;
+    }
+
+    it->second.push_back(callback);
+
+    return true;
+}
+
+// Pass the outcome of the request with the given key to the callers waiting on it, from the executor's thread. Each
+//  one gets its own copy of the response, since callbacks can take the response data over. The last one gets the copy
+//  kept for the notification itself
+void ctn::CtnApiInternals::completeInflightRequest(const std::string &key, std::exception_ptr error, const std::string &response_data)
+{
+    std::vector<HttpCallback> waiters;
 
-    // Set up TCP/IP connection with server and send request
-    try
     {
+        std::lock_guard<std::mutex> lock(this->inflight_mutex_);
+        auto it = this->inflight_requests_.find(key);
+
+        waiters.swap(it->second);
+        this->inflight_requests_.erase(it);
+    }
+
+    if (waiters.empty()) return;
+
+    std::string data(response_data);
+
+    auto notify = [waiters, error, data]() mutable {
+        for (std::size_t idx = 0; idx < waiters.size(); idx++) {
+            if (idx + 1 == waiters.size()) {
+                waiters[idx](error, data);
+            }
+            else {
+                std::string waiter_data(data);
+                waiters[idx](error, waiter_data);
+            }
+        }
+    };
+
+    if (this->executor_->runningInThisThread()) notify();
+    else this->executor_->post(notify);
+}
+
+// http request
+void ctn::CtnApiInternals::httpRequest(ApiRequest request, std::string &response_data)
+{
 #if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-        boost::asio::io_context ioc;
-        ssl::context ctx(ssl::context::sslv23_client);
-
-        tcp::socket socket(ioc);
-        ssl::stream<tcp::socket> ssl_stream(ioc, ctx);
-
-        // Look up the domain name
-        tcp::resolver resolver(ioc);
-        auto const results = resolver.resolve(host_, !port_.empty() ? port_ : (secure_ ? "https" : "http"));
-
-        if (secure_) {
-            // Set SNI Hostname (many hosts need this to handshake successfully)
-            if(! SSL_set_tlsext_host_name(ssl_stream.native_handle(), host_.c_str()))
-            {
-                boost::system::error_code ec(static_cast<int>(::ERR_get_error()), boost::asio::error::get_ssl_category());
-                throw boost::system::system_error(ec);
+    checkBlockingCallAllowed();
+
+    std::promise<std::string> promise;
+    std::future<std::string> future = promise.get_future();
+
+    httpRequestAsync(std::move(request), [&promise](std::exception_ptr error, std::string &data) {
+        if (error) promise.set_exception(error);
+        else promise.set_value(std::move(data));
+    });
+
+    response_data = future.get();
+#elif defined(COM_SUPPORT_LIB_POCO)
+    // Blocking request is simply performed on the calling thread
+    if (!request.timeouts) request.timeouts = currentTimeouts();
+    startDeadline(request);
+
+    if (request.verb != "GET") return runHttpRequest(request, response_data);
+
+    std::string key = inflightRequestKey(request);
+    std::promise<std::string> promise;
+    std::future<std::string> shared = promise.get_future();
+
+    if (joinInflightRequest(key, [&promise](std::exception_ptr error, std::string &data) {
+        if (error) promise.set_exception(error);
+        else promise.set_value(std::move(data));
+    })) {
+        // Same request already in progress
+        response_data = shared.get();
+        return;
+    }
+
+    try {
+        runHttpRequest(request, response_data);
+    }
+    catch (...) {
+        completeInflightRequest(key, std::current_exception(), std::string());
+        throw;
+    }
+
+    completeInflightRequest(key, std::exception_ptr(), response_data);
+#endif
+}
+
+#if defined(COM_SUPPORT_LIB_POCO)
+// Perform a blocking http request, retrying it if allowed
+void ctn::CtnApiInternals::runHttpRequest(ApiRequest &request, std::string &response_data)
+{
+    bool retriable = isRetriable(request);
+    std::chrono::milliseconds delay(0);
+
+    for (unsigned int attempt = 1; ; attempt++) {
+        try {
+            // Request is signed anew on each attempt
+            sendHttpRequest(request, response_data);
+            return;
+        }
+        catch (...) {
+            if (!retriable) throw;
+
+            std::chrono::milliseconds next_delay = nextRetryDelay(delay);
+
+            if (!retryWithinDeadline(request, next_delay) || !shouldRetry(std::current_exception(), attempt)) throw;
+
+            delay = next_delay;
+        }
+
+        std::this_thread::sleep_for(delay);
+    }
+}
+
+// Perform a single attempt of a blocking http request, once admitted by the request scheduler
+void ctn::CtnApiInternals::sendHttpRequest(ApiRequest &request, std::string &response_data)
+{
+    if (!this->scheduler_->enabled()) return issueHttpRequest(request, response_data);
+
+    // Time spent waiting to be admitted counts toward the deadline of the request
+    if (!this->scheduler_->acquire(request.priority, request.deadline)) throw CatenisTimeoutError("deadline");
+
+    try {
+        issueHttpRequest(request, response_data);
+    }
+    catch (...) {
+        this->scheduler_->release();
+        throw;
+    }
+
+    this->scheduler_->release();
+}
+
+void ctn::CtnApiInternals::issueHttpRequest(ApiRequest &request, std::string &response_data)
+{
+    std::string methodpath;
+    std::map<std::string, std::string> headers;
+
+    prepareRequest(request, methodpath, headers);
+
+    unsigned int status_code;
+    std::string status_message;
+
+    try {
+        performRequest(request.verb, methodpath, headers, request.payload, *request.timeouts, request.deadline, status_code, status_message, response_data);
+    }
+    catch (Poco::Exception &ex) {
+        throw CatenisClientError(ex.displayText());
+    }
+
+    completeHttpRequest(status_code, status_message, response_data, [](std::exception_ptr error, std::string &) {
+        if (error) std::rethrow_exception(error);
+    });
+}
+#endif
+
+// Asynchronous http request. Callback is invoked from the executor's thread
+void ctn::CtnApiInternals::httpRequestAsync(ApiRequest request, HttpCallback callback)
+{
+    if (!request.timeouts) request.timeouts = currentTimeouts();
+    startDeadline(request);
+
+    if (request.verb != "GET") return startHttpRequestAsync(std::move(request), callback);
+
+    // Concurrent callers of the same GET request share the one that is issued first, along with its timeouts
+    std::string key = inflightRequestKey(request);
+
+    if (joinInflightRequest(key, callback)) return;
+
+    try {
+        startHttpRequestAsync(std::move(request), [this, key, callback](std::exception_ptr error, std::string &response_data) {
+            this->completeInflightRequest(key, error, response_data);
+            callback(error, response_data);
+        });
+    }
+    catch (...) {
+        // Request could not be issued. Callers that joined in the meantime get the same error
+        completeInflightRequest(key, std::current_exception(), std::string());
+        throw;
+    }
+}
+
+// Asynchronous http request, retried if allowed
+void ctn::CtnApiInternals::startHttpRequestAsync(ApiRequest request, HttpCallback callback)
+{
+    if (!isRetriable(request)) return sendHttpRequestAsync(std::move(request), callback);
+
+    std::shared_ptr<RetryState> state(new RetryState(std::move(request), callback));
+
+    attemptHttpRequestAsync(state);
+}
+
+// Perform an attempt of an asynchronous http request that can be retried. The request is signed anew on each attempt
+void ctn::CtnApiInternals::attemptHttpRequestAsync(std::shared_ptr<RetryState> state)
+{
+    state->attempt++;
+
+    try {
+        sendHttpRequestAsync(state->request, [this, state](std::exception_ptr error, std::string &response_data) {
+            std::chrono::milliseconds delay = error ? this->nextRetryDelay(state->delay) : std::chrono::milliseconds(0);
+
+            if (error && retryWithinDeadline(state->request, delay) && this->shouldRetry(error, state->attempt)) {
+                state->delay = delay;
+
+                return this->executor_->postAfter(state->delay, [this, state]() {
+                    this->attemptHttpRequestAsync(state);
+                });
             }
 
-            // Open connection
-            boost::asio::connect(ssl_stream.lowest_layer(), results.begin(), results.end());
+            state->callback(error, response_data);
+        });
+    }
+    catch (...) {
+        // Retried request could not be issued
+        if (state->attempt == 1) throw;
+
+        std::string response_data;
+        state->callback(std::current_exception(), response_data);
+    }
+}
+
+// Perform a single attempt of an asynchronous http request, once admitted by the request scheduler
+void ctn::CtnApiInternals::sendHttpRequestAsync(ApiRequest request, HttpCallback callback)
+{
+    if (!this->scheduler_->enabled()) return issueHttpRequestAsync(std::move(request), callback);
+
+    std::shared_ptr<ApiRequest> scheduled(new ApiRequest(std::move(request)));
+    RequestPriority priority = scheduled->priority;
+    std::chrono::steady_clock::time_point deadline = scheduled->deadline;
 
-            // Perform the SSL handshake
-            ssl_stream.set_verify_mode(boost::asio::ssl::verify_none);
-            ssl_stream.handshake(ssl::stream_base::client);
+    // Request is only signed once admitted, so its timestamp is not already old when it is sent
+    this->scheduler_->schedule(priority, [this, scheduled, callback]() {
+        HttpCallback on_complete = [this, callback](std::exception_ptr error, std::string &response_data) {
+            this->scheduler_->release();
+            callback(error, response_data);
+        };
+
+        try {
+            this->issueHttpRequestAsync(std::move(*scheduled), on_complete);
         }
-        else {
-            // Open the connection
-            boost::asio::connect(socket, results.begin(), results.end());
+        catch (...) {
+            std::string response_data;
+            on_complete(std::current_exception(), response_data);
+        }
+    }, deadline, [this, callback]() {
+        // Deadline passed while waiting to be admitted. Callback is still invoked from the executor's thread
+        this->executor_->post([callback]() {
+            std::string response_data;
+            callback(std::make_exception_ptr(CatenisTimeoutError("deadline")), response_data);
+        });
+    });
+}
+
+void ctn::CtnApiInternals::issueHttpRequestAsync(ApiRequest request, HttpCallback callback)
+{
+    std::string methodpath;
+    std::map<std::string, std::string> headers;
+
+    prepareRequest(request, methodpath, headers);
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    std::shared_ptr<HttpExchange> exchange(new HttpExchange(this->executor_->ioContext(), *this->connection_pool_, request.timeouts, request.deadline,
+            [this, callback](const boost::system::error_code &ec, http::response<http::string_body> &res) {
+        if (ec.category() == timeoutCategory()) {
+            return callback(std::make_exception_ptr(CatenisTimeoutError(ec.message())), res.body());
+        }
+
+        if (ec) {
+            return callback(std::make_exception_ptr(CatenisClientError(ec.message())), res.body());
+        }
+
+        this->completeHttpRequest(res.result_int(), res.reason().to_string(), res.body(), callback);
+    }));
+
+    // Prepare HTTP request
+    http::request<http::string_body> &req = exchange->request();
+
+    req.method(request.verb == "POST" ? http::verb::post : http::verb::get);
+    req.target(methodpath);
+    req.version(11);
+
+    // Add headers
+    for (auto const &header : headers)
+    {
+        req.set(header.first, header.second);
+    }
+
+    req.set(http::field::content_type, "application/json; charset=utf-8");
+    req.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
+    req.keep_alive(true);
+
+    // add payload
+    req.body() = std::move(request.payload);
+    req.prepare_payload();
+
+    this->executor_->post([exchange]() {
+        exchange->start();
+    });
+#elif defined(COM_SUPPORT_LIB_POCO)
+    std::shared_ptr<ApiRequest> prepared(new ApiRequest(std::move(request)));
+    prepared->methodpath = methodpath;
+
+    this->executor_->post([this, prepared, headers, callback]() {
+        unsigned int status_code;
+        std::string status_message;
+        std::string response_data;
+
+        try {
+            this->performRequest(prepared->verb, prepared->methodpath, headers, prepared->payload, *prepared->timeouts, prepared->deadline, status_code, status_message, response_data);
+        }
+        catch (CatenisTimeoutError &) {
+            return callback(std::current_exception(), response_data);
         }
+        catch (Poco::Exception &ex) {
+            return callback(std::make_exception_ptr(CatenisClientError(ex.displayText())), response_data);
+        }
+
+        this->completeHttpRequest(status_code, status_message, response_data, callback);
+    });
+#endif
+}
+
+// Only requests of API methods that do not change any state are retried
+bool ctn::CtnApiInternals::isRetriable(const ApiRequest &request)
+{
+    if (request.verb != "GET" || this->retry_options_.maxAttempts <= 1) return false;
 
-        // Prepare HTTP request
-        http::request<http::string_body> req(verb == "POST" ? http::verb::post : http::verb::get, methodpath, 11);
+    // Each retriable request earns a fraction of a retry
+    std::lock_guard<std::mutex> lock(this->retry_mutex_);
+
+    this->retry_tokens_ = std::min(this->retry_tokens_ + this->retry_options_.budgetRatio, static_cast<double>(this->retry_options_.budget));
+
+    return true;
+}
+
+// Check whether a failed attempt of a retriable request should be retried, and take the retry from the budget if so
+bool ctn::CtnApiInternals::shouldRetry(std::exception_ptr error, unsigned int attempt)
+{
+    if (attempt >= this->retry_options_.maxAttempts) return false;
+
+    try {
+        std::rethrow_exception(error);
+    }
+    catch (CatenisAPIError &ex) {
+        // Only errors that may go away by themselves: request timeout, too many requests, and server unavailability
+        int status_code = ex.getHttpStatusCode();
+
+        if (status_code != 408 && status_code != 429 && status_code != 500 && status_code != 502 && status_code != 503
+                && status_code != 504) {
+            return false;
+        }
+    }
+    catch (CatenisTimeoutError &ex) {
+        // No time left for another attempt
+        if (ex.getPhase() == "deadline") return false;
+    }
+    catch (CatenisClientError &) {
+        // Connection errors
+    }
+    catch (...) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(this->retry_mutex_);
+
+    if (this->retry_tokens_ < 1.0) return false;
+
+    this->retry_tokens_ -= 1.0;
+
+    return true;
+}
+
+// Time to wait before the next retry (decorrelated jitter): a random time between the base delay and three times the
+//  previous delay, but no longer than the maximum delay
+std::chrono::milliseconds ctn::CtnApiInternals::nextRetryDelay(std::chrono::milliseconds previous_delay)
+{
+    unsigned long base_delay = this->retry_options_.baseDelay;
+    unsigned long upper_delay = std::max(base_delay, static_cast<unsigned long>(previous_delay.count()) * 3);
+
+    std::lock_guard<std::mutex> lock(this->retry_mutex_);
+
+    unsigned long delay = std::uniform_int_distribution<unsigned long>(base_delay, upper_delay)(this->retry_rng_);
+
+    return std::chrono::milliseconds(std::min(delay, static_cast<unsigned long>(this->retry_options_.maxDelay)));
+}
+
+// Report API error for unsuccessful responses
+void ctn::CtnApiInternals::completeHttpRequest(unsigned int status_code, const std::string &status_message, std::string &response_data, const HttpCallback &callback)
+{
+    if (status_code != 200) {
+        std::exception_ptr error;
+
+        try {
+            ApiErrorResponse errorResponse;
+            parseApiErrorResponse(errorResponse, response_data);
+
+            throw CatenisAPIError(status_message, status_code, errorResponse);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        return callback(error, response_data);
+    }
+
+    callback(std::exception_ptr(), response_data);
+}
+
+#if defined(COM_SUPPORT_LIB_POCO)
+// Errors indicating that a reused keep-alive connection had been closed by the server
+static bool isStaleConnectionError(const Poco::Exception &ex)
+{
+    return dynamic_cast<const Poco::Net::ConnectionResetException *>(&ex) != nullptr
+            || dynamic_cast<const Poco::Net::ConnectionAbortedException *>(&ex) != nullptr
+            || dynamic_cast<const Poco::Net::NoMessageException *>(&ex) != nullptr
+            || dynamic_cast<const Poco::Net::SSLConnectionUnexpectedlyClosedException *>(&ex) != nullptr;
+}
+
+// Time allowed for a phase of a request, bounded by the time left before its deadline. A timeout of 0 means no limit
+static Poco::Timespan phaseTimeout(unsigned int timeout, std::chrono::steady_clock::time_point deadline, bool &bounded_by_deadline)
+{
+    std::chrono::milliseconds allowed(timeout);
+
+    bounded_by_deadline = false;
+
+    if (deadline != std::chrono::steady_clock::time_point::max()) {
+        std::chrono::milliseconds left = std::max(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()), std::chrono::milliseconds(1));
+
+        if (timeout == 0 || left < allowed) {
+            allowed = left;
+            bounded_by_deadline = true;
+        }
+    }
+
+    // Poco gives up right away on a zero connection timeout, so no limit is set as a very long one instead
+    if (allowed.count() == 0) return Poco::Timespan(365, 0, 0, 0, 0);
+
+    return Poco::Timespan(static_cast<Poco::Timespan::TimeDiff>(allowed.count()) * 1000);
+}
+
+// Send request over a pooled keep-alive connection, and wait for its response
+void ctn::CtnApiInternals::performRequest(const std::string &verb, const std::string &methodpath, const std::map<std::string, std::string> &headers, const std::string &payload, const RequestTimeouts &timeouts, std::chrono::steady_clock::time_point deadline, unsigned int &status_code, std::string &status_message, std::string &response_data)
+{
+    // Prepare path
+    Poco::URI uri(methodpath);
+    std::string path(uri.getPathAndQuery());
+    if (path.empty()) path = "/";
+
+    // Make request and add header
+    Poco::Net::HTTPRequest request(verb, path, Poco::Net::HTTPMessage::HTTP_1_1);
+    for(auto const &data : headers)
+    {
+        request.add(data.first, data.second);
+    }
+    request.setContentType("application/json; charset=utf-8");
+    request.setContentLength(payload.length());
+    request.setKeepAlive(true);
+
+    while (true) {
+        std::unique_ptr<CtnApiConnection> connection = this->connection_pool_->acquire(deadline);
+
+        if (!connection) throw CatenisTimeoutError("deadline");
+
+        bool reused = connection->reused;
+
+        // Connection is (re)opened along with sending the request. With secure connections, the TLS handshake is part of
+        //  opening it
+        unsigned int open_timeout = timeouts.connect;
+
+        if (this->secure_ && open_timeout > 0) {
+            open_timeout = timeouts.tlsHandshake > 0 ? open_timeout + timeouts.tlsHandshake : 0;
+        }
+
+        bool connect_bounded, send_bounded, receive_bounded;
+        Poco::Timespan connect_timeout = phaseTimeout(open_timeout, deadline, connect_bounded);
+        Poco::Timespan send_timeout = phaseTimeout(timeouts.send, deadline, send_bounded);
+        Poco::Timespan receive_timeout = phaseTimeout(timeouts.receive, deadline, receive_bounded);
+
+        connection->session->setTimeout(connect_timeout, send_timeout, receive_timeout);
+
+        bool connecting = !connection->session->connected();
+        std::string phase;
+        bool bounded;
+        bool request_sent = false;
+
+        Poco::Net::HTTPResponse res;
+
+        try {
+            // Send Request
+            phase = connecting ? "connect" : "send";
+            bounded = connecting ? connect_bounded : send_bounded;
+
+            connection->session->sendRequest(request) << payload;
+            request_sent = true;
+
+            // Get response and copy to response_data
+            phase = "receive";
+            bounded = receive_bounded;
+
+            response_data.clear();
+            Poco::StreamCopier::copyToString(connection->session->receiveResponse(res), response_data);
+        }
+        catch (Poco::TimeoutException &) {
+            this->connection_pool_->release(std::move(connection), false);
+
+            throw CatenisTimeoutError(bounded ? "deadline" : phase);
+        }
+        catch (Poco::Exception &ex) {
+            this->connection_pool_->release(std::move(connection), false);
+
+            // Server may have closed an idle connection: retry it over another one, unless the server may have
+            //  processed the request, which is only sent again if it does not change any state
+            if (reused && isStaleConnectionError(ex) && (!request_sent || verb == "GET"))
+                continue;
+
+            throw;
+        }
+
+        this->connection_pool_->release(std::move(connection), res.getKeepAlive());
+
+        status_code = res.getStatus();
+        status_message = res.getReason();
+        break;
+    }
+}
+#endif
+
+// Generate Signature and add to request
+void ctn::CtnApiInternals::signRequest(const std::string &verb, const std::string &endpoint, std::map<std::string, std::string> &headers, const std::string &payload_hash, time_t now)
+{
+    std::string const &timestamp = headers[TIME_STAMP_HDR];
+    const CtnApiSigningKey &signing_key = currentSigningKey(now);
+    
+    // 1) Hash conformed request. Its components are fed to the digest as they are, instead of being concatenated first
+    CtnApiSha256 conf_req_hash;
+    conf_req_hash.update(verb).update('\n');
+    conf_req_hash.update(endpoint).update('\n');
+    for(auto const &data : headers)
+    {
+        // All header must be in lower case
+        conf_req_hash.update(data.first).update(':').update(data.second).update('\n');
+    }
+    conf_req_hash.update('\n').update(payload_hash).update('\n');
+
+    char conf_req_digest[SHA256_HEX_LENGTH];
+    conf_req_hash.hexDigest(conf_req_digest);
+    
+    // 2) Assemble string to sign
+    std::string str_to_sign = SIGN_METHOD_ID + "\n";
+    str_to_sign += timestamp + "\n";
+    std::string scope = signing_key.signDate() + "/" + SCOPE_REQUEST;
+    str_to_sign += scope + "\n";
+    str_to_sign.append(conf_req_digest, sizeof conf_req_digest) += "\n";
+    
+    // 3) Generate signature
+    std::string signature = signing_key.sign(str_to_sign);
+    
+    // 4) add auth header
+    headers["authorization"] = SIGN_METHOD_ID + " Credential=" + this->device_id_ + "/" + scope + ", Signature=" + signature;
+    
+    return;
+}
+
+// Get signing key for a request issued at the given time. The last derived key is reused while it is valid
+const ctn::CtnApiSigningKey &ctn::CtnApiInternals::currentSigningKey(time_t now)
+{
+    const CtnApiSigningKey *signing_key = this->signing_key_.load(std::memory_order_acquire);
+
+    if (signing_key != nullptr && signing_key->isValidAt(now)) return *signing_key;
+
+    // Key needs to be (re)derived. Make sure that only one thread does it
+    std::lock_guard<std::mutex> lock(this->signkey_mutex_);
+
+    signing_key = this->signing_key_.load(std::memory_order_relaxed);
+
+    if (signing_key == nullptr || !signing_key->isValidAt(now)) {
+        std::unique_ptr<const CtnApiSigningKey> new_signing_key(new CtnApiSigningKey(this->api_access_secret_, now));
+
+        // The key dropped here was replaced when the expiring key was published, at least SIGN_VALID_DAYS ago, so
+        //  no thread can still be signing with it
+        this->previous_signing_key_ = std::move(this->current_signing_key_);
+        this->current_signing_key_ = std::move(new_signing_key);
+
+        signing_key = this->current_signing_key_.get();
+        this->signing_key_.store(signing_key, std::memory_order_release);
+    }
+
+    return *signing_key;
+}
+
+//Contructor
+ctn::CtnApiInternals::CtnApiInternals(std::string device_id, std::string api_access_secret, std::string host, std::string port, std::string environment, bool secure, std::string version, const ClientOptions &options)
+    : signing_key_(nullptr)
+{
+    this->device_id_ = device_id;
+    this->api_access_secret_ = api_access_secret;
+    
+    this->port_ = port;
+    this->secure_ = secure;
+    this->version_ = version;
+    
+    //if sandbox, make host sandbox.catenis.io
+    this->subdomain_ = (environment == "sandbox" ? "sandbox." : "");
+    this->host_ = this->subdomain_ + host;
+        
+    this->root_api_endpoint_ = API_PATH + this->version_;
+
+    this->timeouts_ = std::make_shared<const RequestTimeouts>(options.timeouts);
+    this->retry_options_ = options.retry;
+    this->retry_tokens_ = options.retry.budget;
+    // Seeded differently by each client, so their retries are not in step
+    this->retry_rng_.seed(std::random_device()());
+    this->max_active_connections_ = options.connectionPool.maxActiveConnections;
+    this->streaming_json_parsing_ = options.streamingJsonParsing;
+
+    if (options.shareDeviceInfo) this->device_table_.reset(new CtnApiDeviceTable());
+
+    this->executor_.reset(new CtnApiExecutor(options.asyncThreads));
+    this->resolver_.reset(new CtnApiResolver(*this->executor_, options.dnsCacheTtl));
+    this->scheduler_.reset(new CtnApiScheduler(*this->executor_, options.scheduler));
+
+    if (!options.resultCache.filePath.empty()) {
+        // Results kept for a device are not returned to another one, nor for another API server
+        std::string owner = this->device_id_ + '\n' + this->host_ + ':' + this->port_ + '\n' + this->version_;
+
+        this->disk_cache_.reset(new CtnApiDiskCache(options.resultCache.filePath, options.resultCache.maxFileSize, owner));
+    }
+
+    if (options.resultCache.maxMessages > 0 || this->disk_cache_) {
+        this->message_cache_.reset(new CtnApiResultCache<ReadMessageResult>(options.resultCache.maxMessages, this->disk_cache_.get(), this->device_table_.get()));
+    }
+
+    if (options.resultCache.maxContainers > 0 || this->disk_cache_) {
+        this->container_cache_.reset(new CtnApiResultCache<RetrieveMessageContainerResult>(options.resultCache.maxContainers, this->disk_cache_.get()));
+    }
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+    this->connection_pool_.reset(new CtnApiConnectionPool(this->executor_->ioContext(), *this->resolver_, this->host_, this->port_, this->secure_, options.connectionPool));
+#elif defined(COM_SUPPORT_LIB_POCO)
+    this->connection_pool_.reset(new CtnApiConnectionPool(*this->resolver_, this->host_, this->port_, this->secure_, options.connectionPool));
+#endif
+}
+
+//Destructor
+ctn::CtnApiInternals::~CtnApiInternals()
+{
+    // Stop run loop before the connections it uses go away. Requests still in flight are abandoned
+    this->executor_->stop();
+    this->connection_pool_.reset();
+    this->resolver_.reset();
+    this->scheduler_.reset();
+}
+
+ctn::TlsSessionStats ctn::CtnApiInternals::tlsSessionStats()
+{
+    return this->connection_pool_->tlsSessionStats();
+}
+
+ctn::SchedulerStats ctn::CtnApiInternals::schedulerStats()
+{
+    return this->scheduler_->stats();
+}
+
+ctn::ResultCacheStats ctn::CtnApiInternals::resultCacheStats()
+{
+    ResultCacheStats stats;
+
+    if (this->message_cache_) this->message_cache_->counters(stats.messageHits, stats.messageMisses);
+    if (this->container_cache_) this->container_cache_->counters(stats.containerHits, stats.containerMisses);
+    if (this->disk_cache_) stats.persistentHits = this->disk_cache_->hits();
+
+    return stats;
+}
+
+void ctn::CtnApiInternals::internDevices(ReadMessageResult &data)
+{
+    if (!this->device_table_) return;
+
+    this->device_table_->intern(data.from);
+}
+
+void ctn::CtnApiInternals::internDevices(ListMessagesResult &data)
+{
+    if (!this->device_table_) return;
+
+    for (auto &message : data.messageList) {
+        this->device_table_->intern(message->from);
+        this->device_table_->intern(message->to);
+    }
+}
+
+void ctn::CtnApiInternals::internDevices(RetrievePermissionRightsResult &data)
+{
+    if (!this->device_table_ || !data.device) return;
+
+    for (auto &device : data.device->allowed) {
+        this->device_table_->intern(device);
+    }
+
+    for (auto &device : data.device->denied) {
+        this->device_table_->intern(device);
+    }
+}
+
+void ctn::CtnApiInternals::post(std::function<void()> task)
+{
+    this->executor_->post(task);
+}
+
+void ctn::CtnApiInternals::invokeMessageScan(long long start, long long end, unsigned int shards, std::function<ApiRequest(long long start, long long end)> make_request, ListMessagesResult &data)
+{
+    checkBlockingCallAllowed();
+
+    data.messageList.clear();
+    data.msgCount = 0;
+    data.countExceeded = false;
+
+    if (start > end) return;
+
+    if (shards == 0) {
+        shards = this->max_active_connections_ > 0 ? this->max_active_connections_ : DEFAULT_BATCH_WINDOW;
+    }
+
+    std::shared_ptr<MessageScanState> state(new MessageScanState());
+
+    state->makeRequest = make_request;
+    state->timeouts = currentTimeouts();
+    state->maxInFlight = shards;
+    state->inFlight = 0;
+    state->countExceeded = false;
+
+    // Split the time frame into shards of (nearly) the same length
+    long long length = end - start + 1;
+    long long count = std::min<long long>(shards, length);
+
+    for (long long idx = 0; idx < count; idx++) {
+        state->frames.push_back(std::make_pair(start + length * idx / count, start + length * (idx + 1) / count - 1));
+    }
+
+    std::future<void> done = state->done.get_future();
+
+    issueMessageScanFrames(state);
+
+    done.wait();
+
+    if (state->error) std::rethrow_exception(state->error);
+
+    // Merge the messages of all shards. Dates are all returned in the same format, so they can be compared as strings
+    std::vector< std::shared_ptr<MessageDescription> > &messages = state->messages;
+    std::unordered_set<std::string> message_ids;
+
+    std::stable_sort(messages.begin(), messages.end(), [](const std::shared_ptr<MessageDescription> &msg1, const std::shared_ptr<MessageDescription> &msg2) {
+        return msg1->date < msg2->date;
+    });
+
+    for (auto &message : messages) {
+        if (message_ids.insert(message->messageId).second) data.messageList.push_back(std::move(message));
+    }
+
+    data.msgCount = static_cast<int>(data.messageList.size());
+    data.countExceeded = state->countExceeded;
+}
+
+// Issue requests for the time frames of a message scan not yet requested, while the window allows it
+void ctn::CtnApiInternals::issueMessageScanFrames(std::shared_ptr<MessageScanState> state)
+{
+    for (;;) {
+        std::pair<long long, long long> frame;
+
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+
+            if (state->frames.empty() || state->inFlight >= state->maxInFlight) return;
+
+            frame = state->frames.front();
+            state->frames.pop_front();
+            state->inFlight++;
+        }
+
+        try {
+            ApiRequest request = state->makeRequest(frame.first, frame.second);
+            request.timeouts = state->timeouts;
+            request.priority = RequestPriority::bulk;
+
+            invokeApiMethodAsync<ListMessagesResult>(std::move(request), &CtnApiInternals::parseListMessages, [this, state, frame](std::exception_ptr error, ListMessagesResult &result) {
+                this->completeMessageScanFrame(state, frame, error, result);
+            });
+        }
+        catch (...) {
+            ListMessagesResult result;
+            completeMessageScanFrame(state, frame, std::current_exception(), result);
+        }
+    }
+}
+
+void ctn::CtnApiInternals::completeMessageScanFrame(std::shared_ptr<MessageScanState> state, std::pair<long long, long long> frame, std::exception_ptr error, ListMessagesResult &result)
+{
+    bool all_done;
+
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+
+        state->inFlight--;
+
+        if (error) {
+            if (!state->error) state->error = error;
+            state->frames.clear();
+        }
+        else if (result.countExceeded && frame.first < frame.second) {
+            // Too many messages. Retrieve each half of the time frame instead
+            long long middle = frame.first + (frame.second - frame.first) / 2;
+
+            state->frames.push_front(std::make_pair(middle + 1, frame.second));
+            state->frames.push_front(std::make_pair(frame.first, middle));
+        }
+        else {
+            if (result.countExceeded) state->countExceeded = true;
+
+            for (auto &message : result.messageList) {
+                state->messages.push_back(std::move(message));
+            }
+        }
+
+        all_done = state->inFlight == 0 && state->frames.empty();
+    }
+
+    if (all_done) state->done.set_value();
+    else issueMessageScanFrames(state);
+}
+
+void ctn::CtnApiInternals::parseApiErrorResponse(ApiErrorResponse &error_response, std::string &json_data) {
+    try {
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+        json_spirit::mValue result;
+        readJsonTree(json_data, result);
+
+        json_spirit::mObject &retObj = result.get_obj();
+
+        std::string const &status = retObj["status"].get_str();
+#elif defined(COM_SUPPORT_LIB_POCO)
+        Poco::JSON::Parser parser;
+        Poco::Dynamic::Var result = parser.parse(json_data);
+
+        Poco::JSON::Object::Ptr retObj = result.extract<Poco::JSON::Object::Ptr>();
+
+        std::string status = retObj->getValue<std::string>("status");
+#endif
+
+        if (status == "error") {
+            error_response.status = status;
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+            error_response.message = retObj["message"].get_str();
+#elif defined(COM_SUPPORT_LIB_POCO)
+            error_response.message = retObj->getValue<std::string>("message");
+#endif
+        } else {
+            throw CatenisClientError("Unexpected API error response");
+        }
+    }
+    catch (...) {
+        throw CatenisClientError("Unexpected API error response");
+    }
+}
+
+// Single pass parsing of API method responses.
+//  The data of a successful response is read straight into a (local) result structure, without building the JSON
+//  document tree. Should the response not be as expected, it is parsed again by the (document tree based) methods
+//  further below, which then report the error
+
+static void throwUnexpectedData()
+{
+    throw ctn::CatenisClientError("Unexpected returned data");
+}
+
+// Read {"status": "success", "data": {...}} response, using read_data to read the contents of its data member
+template<typename Result>
+static bool readSuccessResponse(const std::string &json_data, Result &data, void (*read_data)(ctn::CtnApiJsonReader &, Result &))
+{
+    try {
+        ctn::CtnApiJsonReader reader(json_data);
+        std::string member;
+        bool success = false;
+        bool has_data = false;
+
+        reader.beginObject();
+
+        while (reader.nextMember(member)) {
+            if (member == "status") {
+                success = reader.readString() == "success";
+            }
+            else if (member == "data") {
+                if (has_data) throwUnexpectedData();
+
+                read_data(reader, data);
+                has_data = true;
+            }
+            else {
+                reader.skipValue();
+            }
+        }
+
+        reader.end();
+
+        return success && has_data;
+    }
+    catch (...) {
+        return false;
+    }
+}
+
+static void readDeviceInfoFields(ctn::CtnApiJsonReader &reader, std::string &deviceId, std::string &name, std::string &prodUniqueId)
+{
+    std::string member;
+    bool has_device_id = false;
+
+    name.clear();
+    prodUniqueId.clear();
+
+    reader.beginObject();
+
+    while (reader.nextMember(member)) {
+        if (member == "deviceId") {
+            reader.readString(deviceId);
+            has_device_id = true;
+        }
+        else if (member == "name") {
+            reader.readString(name);
+        }
+        else if (member == "prodUniqueId") {
+            reader.readString(prodUniqueId);
+        }
+        else {
+            reader.skipValue();
+        }
+    }
+
+    if (!has_device_id) throwUnexpectedData();
+}
+
+static std::shared_ptr<ctn::DeviceInfo> readDeviceInfo(ctn::CtnApiJsonReader &reader)
+{
+    std::string deviceId;
+    std::string name;
+    std::string prodUniqueId;
+
+    readDeviceInfoFields(reader, deviceId, name, prodUniqueId);
+
+    return std::shared_ptr<ctn::DeviceInfo>(new ctn::DeviceInfo(deviceId, name, prodUniqueId));
+}
+
+static void readStringList(ctn::CtnApiJsonReader &reader, std::list<std::string> &list)
+{
+    reader.beginArray();
+
+    while (reader.nextElement()) {
+        list.push_back(reader.readString());
+    }
+}
+
+static void readDeviceInfoList(ctn::CtnApiJsonReader &reader, std::list< std::shared_ptr<ctn::DeviceInfo> > &list)
+{
+    reader.beginArray();
+
+    while (reader.nextElement()) {
+        list.push_back(readDeviceInfo(reader));
+    }
+}
+
+// Read object whose members are all strings
+static void readStringDictionary(ctn::CtnApiJsonReader &reader, std::map<std::string, std::string> &dictionary)
+{
+    std::string member;
+
+    reader.beginObject();
+
+    while (reader.nextMember(member)) {
+        reader.readString(dictionary[member]);
+    }
+}
+
+// Log Message and Send Message responses
+template<typename Result>
+static void readMessageIdData(ctn::CtnApiJsonReader &reader, Result &data)
+{
+    std::string member;
+    bool has_message_id = false;
+
+    reader.beginObject();
+
+    while (reader.nextMember(member)) {
+        if (member == "messageId") {
+            reader.readString(data.messageId);
+            has_message_id = true;
+        }
+        else {
+            reader.skipValue();
+        }
+    }
+
+    if (!has_message_id) throwUnexpectedData();
+}
+
+static void readReadMessageData(ctn::CtnApiJsonReader &reader, ctn::ReadMessageResult &data)
+{
+    std::string member;
+    bool has_action = false;
+    bool has_message = false;
+
+    reader.beginObject();
+
+    while (reader.nextMember(member)) {
+        if (member == "action") {
+            reader.readString(data.action);
+            has_action = true;
+        }
+        else if (member == "from") {
+            data.from = readDeviceInfo(reader);
+        }
+        else if (member == "message") {
+            reader.readString(data.message);
+            has_message = true;
+        }
+        else {
+            reader.skipValue();
+        }
+    }
+
+    if (!has_action || !has_message) throwUnexpectedData();
+}
+
+static void readRetrieveMessageContainerData(ctn::CtnApiJsonReader &reader, ctn::RetrieveMessageContainerResult &data)
+{
+    std::string member;
+    bool has_txid = false;
+    bool has_is_confirmed = false;
+
+    reader.beginObject();
+
+    while (reader.nextMember(member)) {
+        if (member == "blockchain") {
+            reader.beginObject();
+
+            while (reader.nextMember(member)) {
+                if (member == "txid") {
+                    reader.readString(data.blockchain.txid);
+                    has_txid = true;
+                }
+                else if (member == "isConfirmed") {
+                    data.blockchain.isConfirmed = reader.readBool();
+                    has_is_confirmed = true;
+                }
+                else {
+                    reader.skipValue();
+                }
+            }
+        }
+        else if (member == "externalStorage") {
+            data.externalStorage.reset(new ctn::StorageProviderDictionary());
+            readStringDictionary(reader, *data.externalStorage);
+        }
+        else {
+            reader.skipValue();
+        }
+    }
+
+    if (!has_txid || !has_is_confirmed) throwUnexpectedData();
+}
+
+static std::shared_ptr<ctn::MessageDescription> readMessageDescription(ctn::CtnApiJsonReader &reader)
+{
+    std::string member;
+    std::string messageId;
+    std::string action;
+    std::string direction;
+    std::shared_ptr<ctn::DeviceInfo> from_device_obj;
+    std::shared_ptr<ctn::DeviceInfo> to_device_obj;
+    std::shared_ptr<bool> read_confirmation_enabled;
+    std::shared_ptr<bool> read;
+    std::string date;
+    bool has_message_id = false;
+    bool has_action = false;
+    bool has_date = false;
+
+    reader.beginObject();
+
+    while (reader.nextMember(member)) {
+        if (member == "messageId") {
+            reader.readString(messageId);
+            has_message_id = true;
+        }
+        else if (member == "action") {
+            reader.readString(action);
+            has_action = true;
+        }
+        else if (member == "direction") {
+            reader.readString(direction);
+        }
+        else if (member == "from") {
+            from_device_obj = readDeviceInfo(reader);
+        }
+        else if (member == "to") {
+            to_device_obj = readDeviceInfo(reader);
+        }
+        else if (member == "readConfirmationEnabled") {
+            read_confirmation_enabled.reset(new bool(reader.readBool()));
+        }
+        else if (member == "read") {
+            read.reset(new bool(reader.readBool()));
+        }
+        else if (member == "date") {
+            reader.readString(date);
+            has_date = true;
+        }
+        else {
+            reader.skipValue();
+        }
+    }
+
+    if (!has_message_id || !has_action || !has_date) throwUnexpectedData();
+
+    return std::shared_ptr<ctn::MessageDescription>(new ctn::MessageDescription(messageId, action, direction, from_device_obj, to_device_obj, read_confirmation_enabled, read, date));
+}
+
+static void readListMessagesData(ctn::CtnApiJsonReader &reader, ctn::ListMessagesResult &data)
+{
+    std::string member;
+    bool has_messages = false;
+    bool has_msg_count = false;
+    bool has_count_exceeded = false;
+
+    reader.beginObject();
+
+    while (reader.nextMember(member)) {
+        if (member == "messages") {
+            reader.beginArray();
+
+            while (reader.nextElement()) {
+                data.messageList.push_back(readMessageDescription(reader));
+            }
+
+            has_messages = true;
+        }
+        else if (member == "msgCount") {
+            data.msgCount = reader.readInt();
+            has_msg_count = true;
+        }
+        else if (member == "countExceeded") {
+            data.countExceeded = reader.readBool();
+            has_count_exceeded = true;
+        }
+        else {
+            reader.skipValue();
+        }
+    }
+
+    if (!has_messages || !has_msg_count || !has_count_exceeded) throwUnexpectedData();
+}
+
+// Index of the device in the device table of a flat List Messages result, adding it to the table if needed
+static int flatDeviceIndex(ctn::FlatListMessagesResult &data, std::unordered_map<std::string, int> &device_indices, const std::string &deviceId, const std::string &name, const std::string &prodUniqueId)
+{
+    auto it = device_indices.find(deviceId);
+
+    if (it != device_indices.end()) return it->second;
+
+    int index = static_cast<int>(data.devices.size());
+
+    data.devices.push_back(ctn::DeviceInfo(deviceId, name, prodUniqueId));
+    device_indices[deviceId] = index;
+
+    return index;
+}
+
+static void readFlatMessageDescription(ctn::CtnApiJsonReader &reader, ctn::FlatListMessagesResult &data, std::unordered_map<std::string, int> &device_indices)
+{
+    data.messages.emplace_back();
+
+    ctn::FlatMessageDescription &message = data.messages.back();
+    std::string member;
+    std::string deviceId;
+    std::string name;
+    std::string prodUniqueId;
+    bool has_message_id = false;
+    bool has_action = false;
+    bool has_date = false;
+
+    reader.beginObject();
+
+    while (reader.nextMember(member)) {
+        if (member == "messageId") {
+            reader.readString(message.messageId);
+            has_message_id = true;
+        }
+        else if (member == "action") {
+            reader.readString(message.action);
+            has_action = true;
+        }
+        else if (member == "direction") {
+            reader.readString(message.direction);
+        }
+        else if (member == "from") {
+            readDeviceInfoFields(reader, deviceId, name, prodUniqueId);
+            message.fromDevice = flatDeviceIndex(data, device_indices, deviceId, name, prodUniqueId);
+        }
+        else if (member == "to") {
+            readDeviceInfoFields(reader, deviceId, name, prodUniqueId);
+            message.toDevice = flatDeviceIndex(data, device_indices, deviceId, name, prodUniqueId);
+        }
+        else if (member == "readConfirmationEnabled") {
+            message.readConfirmationEnabled = reader.readBool();
+            message.hasReadConfirmationEnabled = true;
+        }
+        else if (member == "read") {
+            message.read = reader.readBool();
+            message.hasRead = true;
+        }
+        else if (member == "date") {
+            reader.readString(message.date);
+            has_date = true;
+        }
+        else {
+            reader.skipValue();
+        }
+    }
+
+    if (!has_message_id || !has_action || !has_date) throwUnexpectedData();
+}
+
+static void readFlatListMessagesData(ctn::CtnApiJsonReader &reader, ctn::FlatListMessagesResult &data)
+{
+    std::string member;
+    std::unordered_map<std::string, int> device_indices;
+    bool has_messages = false;
+    bool has_msg_count = false;
+    bool has_count_exceeded = false;
+
+    reader.beginObject();
+
+    while (reader.nextMember(member)) {
+        if (member == "messages") {
+            reader.beginArray();
+
+            while (reader.nextElement()) {
+                readFlatMessageDescription(reader, data, device_indices);
+            }
+
+            has_messages = true;
+        }
+        else if (member == "msgCount") {
+            data.msgCount = reader.readInt();
+            has_msg_count = true;
+        }
+        else if (member == "countExceeded") {
+            data.countExceeded = reader.readBool();
+            has_count_exceeded = true;
+        }
+        else {
+            reader.skipValue();
+        }
+    }
+
+    if (!has_messages || !has_msg_count || !has_count_exceeded) throwUnexpectedData();
+}
+
+// Readers of results held in a result arena. String values are first read into a scratch string, whose memory is
+//  reused from one value to the next, and then copied into the arena
+
+static void readArenaString(ctn::CtnApiJsonReader &reader, std::string &scratch, ctn::ArenaString &value)
+{
+    reader.readString(scratch);
+    value.assign(scratch.data(), scratch.size());
+}
+
+static void readArenaDeviceInfo(ctn::CtnApiJsonReader &reader, std::string &scratch, ctn::ArenaDeviceInfo &device)
+{
+    std::string member;
+    bool has_device_id = false;
+
+    reader.beginObject();
+
+    while (reader.nextMember(member)) {
+        if (member == "deviceId") {
+            readArenaString(reader, scratch, device.deviceId);
+            has_device_id = true;
+        }
+        else if (member == "name") {
+            readArenaString(reader, scratch, device.name);
+        }
+        else if (member == "prodUniqueId") {
+            readArenaString(reader, scratch, device.prodUniqueId);
+        }
+        else {
+            reader.skipValue();
+        }
+    }
+
+    if (!has_device_id) throwUnexpectedData();
+}
+
+static void readArenaMessageDescription(ctn::CtnApiJsonReader &reader, std::string &scratch, ctn::ArenaMessageDescription &message)
+{
+    std::string member;
+    bool has_message_id = false;
+    bool has_action = false;
+    bool has_date = false;
+
+    reader.beginObject();
+
+    while (reader.nextMember(member)) {
+        if (member == "messageId") {
+            readArenaString(reader, scratch, message.messageId);
+            has_message_id = true;
+        }
+        else if (member == "action") {
+            readArenaString(reader, scratch, message.action);
+            has_action = true;
+        }
+        else if (member == "direction") {
+            readArenaString(reader, scratch, message.direction);
+        }
+        else if (member == "from") {
+            readArenaDeviceInfo(reader, scratch, message.from);
+            message.hasFrom = true;
+        }
+        else if (member == "to") {
+            readArenaDeviceInfo(reader, scratch, message.to);
+            message.hasTo = true;
+        }
+        else if (member == "readConfirmationEnabled") {
+            message.readConfirmationEnabled = reader.readBool();
+            message.hasReadConfirmationEnabled = true;
+        }
+        else if (member == "read") {
+            message.read = reader.readBool();
+            message.hasRead = true;
+        }
+        else if (member == "date") {
+            readArenaString(reader, scratch, message.date);
+            has_date = true;
+        }
+        else {
+            reader.skipValue();
+        }
+    }
+
+    if (!has_message_id || !has_action || !has_date) throwUnexpectedData();
+}
+
+static void readArenaListMessagesData(ctn::CtnApiJsonReader &reader, ctn::ArenaListMessagesResult &data)
+{
+    std::string member;
+    std::string scratch;
+    bool has_messages = false;
+    bool has_msg_count = false;
+    bool has_count_exceeded = false;
+
+    reader.beginObject();
+
+    while (reader.nextMember(member)) {
+        if (member == "messages") {
+            reader.beginArray();
+
+            while (reader.nextElement()) {
+                data.messages.emplace_back(data.arena());
+                readArenaMessageDescription(reader, scratch, data.messages.back());
+            }
+
+            has_messages = true;
+        }
+        else if (member == "msgCount") {
+            data.msgCount = reader.readInt();
+            has_msg_count = true;
+        }
+        else if (member == "countExceeded") {
+            data.countExceeded = reader.readBool();
+            has_count_exceeded = true;
+        }
+        else {
+            reader.skipValue();
+        }
+    }
+
+    if (!has_messages || !has_msg_count || !has_count_exceeded) throwUnexpectedData();
+}
+
+// Readers of view results, whose string members refer to the returned data
+
+static void readStringView(ctn::CtnApiJsonReader &reader, ctn::JsonStringView &value)
+{
+    const char *data;
+    std::size_t size;
+    bool escaped;
+
+    reader.readRawString(data, size, escaped);
+    value = ctn::JsonStringView(data, size, escaped);
+}
+
+static void readDeviceInfoView(ctn::CtnApiJsonReader &reader, ctn::DeviceInfoView &device)
+{
+    std::string member;
+    bool has_device_id = false;
+
+    reader.beginObject();
+
+    while (reader.nextMember(member)) {
+        if (member == "deviceId") {
+            readStringView(reader, device.deviceId);
+            has_device_id = true;
+        }
+        else if (member == "name") {
+            readStringView(reader, device.name);
+        }
+        else if (member == "prodUniqueId") {
+            readStringView(reader, device.prodUniqueId);
+        }
+        else {
+            reader.skipValue();
+        }
+    }
+
+    if (!has_device_id) throwUnexpectedData();
+}
+
+static void readReadMessageViewData(ctn::CtnApiJsonReader &reader, ctn::ReadMessageView &data)
+{
+    std::string member;
+    bool has_action = false;
+    bool has_message = false;
+
+    reader.beginObject();
+
+    while (reader.nextMember(member)) {
+        if (member == "action") {
+            readStringView(reader, data.action);
+            has_action = true;
+        }
+        else if (member == "from") {
+            readDeviceInfoView(reader, data.from);
+            data.hasFrom = true;
+        }
+        else if (member == "message") {
+            readStringView(reader, data.message);
+            has_message = true;
+        }
+        else {
+            reader.skipValue();
+        }
+    }
+
+    if (!has_action || !has_message) throwUnexpectedData();
+}
+
+static void readMessageDescriptionView(ctn::CtnApiJsonReader &reader, ctn::MessageDescriptionView &message)
+{
+    std::string member;
+    bool has_message_id = false;
+    bool has_action = false;
+    bool has_date = false;
+
+    reader.beginObject();
+
+    while (reader.nextMember(member)) {
+        if (member == "messageId") {
+            readStringView(reader, message.messageId);
+            has_message_id = true;
+        }
+        else if (member == "action") {
+            readStringView(reader, message.action);
+            has_action = true;
+        }
+        else if (member == "direction") {
+            readStringView(reader, message.direction);
+        }
+        else if (member == "from") {
+            readDeviceInfoView(reader, message.from);
+            message.hasFrom = true;
+        }
+        else if (member == "to") {
+            readDeviceInfoView(reader, message.to);
+            message.hasTo = true;
+        }
+        else if (member == "readConfirmationEnabled") {
+            message.readConfirmationEnabled = reader.readBool();
+            message.hasReadConfirmationEnabled = true;
+        }
+        else if (member == "read") {
+            message.read = reader.readBool();
+            message.hasRead = true;
+        }
+        else if (member == "date") {
+            readStringView(reader, message.date);
+            has_date = true;
+        }
+        else {
+            reader.skipValue();
+        }
+    }
+
+    if (!has_message_id || !has_action || !has_date) throwUnexpectedData();
+}
+
+static void readListMessagesViewData(ctn::CtnApiJsonReader &reader, ctn::ListMessagesView &data)
+{
+    std::string member;
+    bool has_messages = false;
+    bool has_msg_count = false;
+    bool has_count_exceeded = false;
+
+    reader.beginObject();
+
+    while (reader.nextMember(member)) {
+        if (member == "messages") {
+            reader.beginArray();
+
+            while (reader.nextElement()) {
+                data.messages.emplace_back();
+                readMessageDescriptionView(reader, data.messages.back());
+            }
+
+            has_messages = true;
+        }
+        else if (member == "msgCount") {
+            data.msgCount = reader.readInt();
+            has_msg_count = true;
+        }
+        else if (member == "countExceeded") {
+            data.countExceeded = reader.readBool();
+            has_count_exceeded = true;
+        }
+        else {
+            reader.skipValue();
+        }
+    }
+
+    if (!has_messages || !has_msg_count || !has_count_exceeded) throwUnexpectedData();
+}
+
+static void readListPermissionEventsData(ctn::CtnApiJsonReader &reader, ctn::ListPermissionEventsResult &data)
+{
+    readStringDictionary(reader, data.permissionEvents);
+}
+
+// Read {"allow": [...], "deny": [...]} object of permission rights
+template<typename List>
+static void readRightsLists(ctn::CtnApiJsonReader &reader, List &allowed, List &denied, void (*read_list)(ctn::CtnApiJsonReader &, List &))
+{
+    std::string member;
+
+    reader.beginObject();
+
+    while (reader.nextMember(member)) {
+        if (member == "allow") {
+            read_list(reader, allowed);
+        }
+        else if (member == "deny") {
+            read_list(reader, denied);
+        }
+        else {
+            reader.skipValue();
+        }
+    }
+}
+
+static void readRetrievePermissionRightsData(ctn::CtnApiJsonReader &reader, ctn::RetrievePermissionRightsResult &data)
+{
+    std::string member;
+    bool has_system = false;
+
+    reader.beginObject();
+
+    while (reader.nextMember(member)) {
+        if (member == "system") {
+            reader.readString(data.system);
+            has_system = true;
+        }
+        else if (member == "catenisNode") {
+            std::list<std::string> allowed;
+            std::list<std::string> denied;
+
+            readRightsLists(reader, allowed, denied, readStringList);
+            data.catenisNode.reset(new ctn::PermissionRightsCatenisNode(allowed, denied));
+        }
+        else if (member == "client") {
+            std::list<std::string> allowed;
+            std::list<std::string> denied;
+
+            readRightsLists(reader, allowed, denied, readStringList);
+            data.client.reset(new ctn::PermissionRightsClient(allowed, denied));
+        }
+        else if (member == "device") {
+            std::list< std::shared_ptr<ctn::DeviceInfo> > allowed;
+            std::list< std::shared_ptr<ctn::DeviceInfo> > denied;
+
+            readRightsLists(reader, allowed, denied, readDeviceInfoList);
+            data.device.reset(new ctn::PermissionRightsDevice(allowed, denied));
+        }
+        else {
+            reader.skipValue();
+        }
+    }
+
+    if (!has_system) throwUnexpectedData();
+}
 
-        // Add headers
-        for (auto const &header : headers)
-        {
-            req.set(header.first, header.second);
-        }
+static void readArenaStringList(ctn::CtnApiJsonReader &reader, std::string &scratch, ctn::ArenaVector<ctn::ArenaString> &list)
+{
+    reader.beginArray();
 
-        req.set(http::field::content_type, "application/json; charset=utf-8");
-        req.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
-        req.set(http::field::connection, "close");
+    while (reader.nextElement()) {
+        list.emplace_back(ctn::ArenaAllocator<char>(list.get_allocator()));
+        readArenaString(reader, scratch, list.back());
+    }
+}
 
-        // add payload
-        req.body() = payload_json;
-        req.prepare_payload();
+static void readArenaDeviceInfoList(ctn::CtnApiJsonReader &reader, std::string &scratch, ctn::ArenaVector<ctn::ArenaDeviceInfo> &list)
+{
+    reader.beginArray();
 
-        // Send the HTTP request
-        if (secure_)
-            http::write(ssl_stream, req);
-        else
-            http::write(socket, req);
+    while (reader.nextElement()) {
+        list.emplace_back(*list.get_allocator().arena());
+        readArenaDeviceInfo(reader, scratch, list.back());
+    }
+}
 
-        // Prepare to receive response.
-        boost::beast::flat_buffer buffer;
-        http::response<http::string_body> res;
+template<typename Entry>
+static void readArenaRights(ctn::CtnApiJsonReader &reader, std::string &scratch, ctn::ArenaPermissionRights<Entry> &rights,
+        void (*read_list)(ctn::CtnApiJsonReader &, std::string &, ctn::ArenaVector<Entry> &))
+{
+    std::string member;
 
-        // Receive the HTTP response
-        if (secure_)
-            http::read(ssl_stream, buffer, res);
-        else
-            http::read(socket, buffer, res);
-
-        // Get response and copy to response_data
-        response_data = res.body();
-
-        unsigned int status_code = res.result_int();
-        std::string status_message = res.reason().to_string();
-
-        // Close connection
-        if (secure_) {
-            // Gracefully close the stream
-            boost::system::error_code ec;
-            ssl_stream.shutdown(ec);
-
-            if(ec == boost::asio::error::eof || ec == ssl::error::stream_errors::stream_truncated) {
-                //std::cerr << ">>>>>> SSL stream shutdown failed: " << ec.message() << std::endl;
-                // Rationale: http://stackoverflow.com/questions/25587403/boost-asio-ssl-async-shutdown-always-finishes-with-an-error
-                ec.assign(0, ec.category());
-            }
+    reader.beginObject();
 
-            if(ec)
-                throw boost::system::system_error(ec);
+    while (reader.nextMember(member)) {
+        if (member == "allow") {
+            read_list(reader, scratch, rights.allowed);
         }
-        else {
-            // Gracefully close the socket
-            boost::system::error_code ec;
-            socket.shutdown(tcp::socket::shutdown_both, ec);
-
-            // not_connected happens sometimes so don't bother reporting it.
-            if (ec && ec != boost::system::errc::not_connected)
-                throw boost::system::system_error(ec);
+        else if (member == "deny") {
+            read_list(reader, scratch, rights.denied);
         }
-#elif defined(COM_SUPPORT_LIB_POCO)
-        // Contruct url
-        std::string prefix = (this->secure_ ? "https://" : "http://");
-        std::string url = prefix + this->host_;
-        if(this->port_ != "") url = url + ":" + this->port_;
-        url = url + methodpath;
-
-        Poco::URI uri(url);
-        // HTTP
-        Poco::Net::HTTPClientSession http_session(uri.getHost(), uri.getPort());
-        // HTTPS
-        const Poco::Net::Context::Ptr context = new Poco::Net::Context(Poco::Net::Context::CLIENT_USE, "", Poco::Net::Context::VERIFY_NONE);
-        Poco::Net::HTTPSClientSession ssl_session(uri.getHost(), uri.getPort(), context);
-
-        // Prepare path
-        std::string path(uri.getPathAndQuery());
-        if (path.empty()) path = "/";
-
-        // Make request and add header
-        Poco::Net::HTTPRequest request(verb, path, Poco::Net::HTTPMessage::HTTP_1_1);
-        for(auto const &data : headers)
-        {
-            request.add(data.first, data.second);
+        else {
+            reader.skipValue();
         }
-        request.setContentType("application/json; charset=utf-8");
-        request.setContentLength(payload_json.length());
-
-        // Send Request
-        if(this->secure_) ssl_session.sendRequest(request) << payload_json;
-        else http_session.sendRequest(request) << payload_json;
-
-        // Get response and copy to response_data
-        Poco::Net::HTTPResponse res;
-        if(this->secure_) Poco::StreamCopier::copyToString(ssl_session.receiveResponse(res), response_data);
-        else Poco::StreamCopier::copyToString(http_session.receiveResponse(res), response_data);
+    }
+}
 
-        unsigned int status_code = res.getStatus();
-        std::string status_message = res.getReason();
-#endif
+static void readArenaRetrievePermissionRightsData(ctn::CtnApiJsonReader &reader, ctn::ArenaRetrievePermissionRightsResult &data)
+{
+    std::string member;
+    std::string scratch;
+    bool has_system = false;
 
-        if (status_code != 200) {
-            ApiErrorResponse errorResponse;
-            parseApiErrorResponse(errorResponse, response_data);
+    reader.beginObject();
 
-            throw CatenisAPIError(status_message, status_code, errorResponse);
+    while (reader.nextMember(member)) {
+        if (member == "system") {
+            readArenaString(reader, scratch, data.system);
+            has_system = true;
+        }
+        else if (member == "catenisNode") {
+            readArenaRights(reader, scratch, data.catenisNode, readArenaStringList);
+            data.hasCatenisNode = true;
+        }
+        else if (member == "client") {
+            readArenaRights(reader, scratch, data.client, readArenaStringList);
+            data.hasClient = true;
+        }
+        else if (member == "device") {
+            readArenaRights(reader, scratch, data.device, readArenaDeviceInfoList);
+            data.hasDevice = true;
+        }
+        else {
+            reader.skipValue();
         }
     }
-#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-    catch (std::exception& e)
-    {
-        throw CatenisClientError(e.what());
-#elif defined(COM_SUPPORT_LIB_POCO)
-    catch (Poco::Exception &ex)
-    {
-        throw CatenisClientError(ex.displayText());
-#endif
-    }
+
+    if (!has_system) throwUnexpectedData();
 }
 
-// Generate Signature and add to request
-void ctn::CtnApiInternals::signRequest(std::string verb, std::string endpoint, std::map<std::string, std::string> &headers, std::string payload, time_t now)
+static void readSetPermissionRightsData(ctn::CtnApiJsonReader &reader, ctn::SetPermissionRightsResult &data)
 {
-    std::string timestamp = headers[TIME_STAMP_HDR];
-    char date_buffer[9];
-    std::string signdate;
-    bool use_same_signkey;
-    
-    // Use last signkey if date < valid days
-    if(this->last_signkey_.length() != 0 && std::difftime(now, this->last_signdate_)/(3600 * 24) < SIGN_VALID_DAYS)
-    {
-        use_same_signkey = true;
-        strftime(date_buffer, sizeof date_buffer, "%Y%m%d", gmtime(&last_signdate_));
-        signdate = std::string(date_buffer);
-    }
-    else
-    {
-        use_same_signkey = false;
-        this->last_signdate_ = now;
-        strftime(date_buffer, sizeof date_buffer, "%Y%m%d", gmtime(&now));
-        signdate = std::string(date_buffer);
-    }
-    
-    // 1) Compute conformed request
-    std::string conf_req = verb + "\n";
-    conf_req += endpoint + "\n";
-    for(auto const &data : headers)
-    {
-        // All header must be in lower case
-        conf_req += data.first + ":" + data.second + "\n";
+    std::string member;
+    bool has_success = false;
+
+    reader.beginObject();
+
+    while (reader.nextMember(member)) {
+        if (member == "success") {
+            data.success = reader.readBool();
+            has_success = true;
+        }
+        else {
+            reader.skipValue();
+        }
     }
-    conf_req += "\n" + hashData(payload) + "\n";
-    
-    // 2) Assemble string to sign
-    std::string str_to_sign = SIGN_METHOD_ID + "\n";
-    str_to_sign += timestamp + "\n";
-    std::string scope = signdate + "/" + SCOPE_REQUEST;
-    str_to_sign += scope + "\n";
-    str_to_sign += hashData(conf_req) + "\n";
-    
-    // 3) Generate signature
-    std::string datekey = signData(SIGN_VERSION_ID + this->api_access_secret_, signdate);
-    std::string signkey;
-    // check bool and use last sign key
-    if(use_same_signkey) signkey = this->last_signkey_;
-    else signkey = this->last_signkey_ = signData(datekey, SCOPE_REQUEST);
-    std::string signature = signData(signkey, str_to_sign, true);
-    
-    // 4) add auth header
-    headers["authorization"] = SIGN_METHOD_ID + " Credential=" + this->device_id_ + "/" + scope + ", Signature=" + signature;
-    
-    return;
+
+    if (!has_success) throwUnexpectedData();
 }
 
-//Contructor
-ctn::CtnApiInternals::CtnApiInternals(std::string device_id, std::string api_access_secret, std::string host, std::string port, std::string environment, bool secure, std::string version)
+static void readListNotificationEventsData(ctn::CtnApiJsonReader &reader, ctn::ListNotificationEventsResult &data)
 {
-    this->device_id_ = device_id;
-    this->api_access_secret_ = api_access_secret;
-    
-    this->port_ = port;
-    this->secure_ = secure;
-    this->version_ = version;
-    
-    //if sandbox, make host sandbox.catenis.io
-    this->subdomain_ = (environment == "sandbox" ? "sandbox." : "");
-    this->host_ = this->subdomain_ + host;
-        
-    this->root_api_endpoint_ = API_PATH + this->version_;
+    readStringDictionary(reader, data.notificationEvents);
 }
 
-// SHA256 Hash
-std::string ctn::CtnApiInternals::hashData(const std::string str)
+static void readCheckEffectivePermissionRightData(ctn::CtnApiJsonReader &reader, ctn::CheckEffectivePermissionRightResult &data)
 {
-    unsigned char hash[SHA256_DIGEST_LENGTH];
-    SHA256_CTX sha256;
-    SHA256_Init(&sha256);
-    SHA256_Update(&sha256, str.c_str(), str.size());
-    SHA256_Final(hash, &sha256);
-    std::stringstream ss;
-    ss << std::hex;
-    for(int i = 0; i < SHA256_DIGEST_LENGTH; i++)
-    {
-        ss << std::setw(2) << std::setfill('0') << (int)hash[i];
-    }
-    return ss.str();
+    readStringDictionary(reader, data.effectivePermissionRight);
 }
 
-// HMAC-SHA256 signing
-std::string ctn::CtnApiInternals::signData(std::string key, std::string data, bool hex_encode)
+static void readRetrieveDeviceIdInfoData(ctn::CtnApiJsonReader &reader, ctn::DeviceIdInfoResult &data)
 {
-    unsigned int len;
-    unsigned char *raw = HMAC(EVP_sha256(), (unsigned char*) key.c_str(), key.length(),  (unsigned char*) data.c_str(), data.length(), NULL, &len);
-    std::stringstream ss;
-    
-    if(hex_encode == false)
-    {
-        return std::string((char *)raw, (std::string::size_type)len);
-    }
-    else
-    {
-        ss << std::hex;
-        for(int i = 0; i < len; i++)
-        {
-            ss << std::setw(2) << std::setfill('0') << (int)raw[i];
-        }
-        
-    }
-    return ss.str();
-}
+    std::string member;
 
-void ctn::CtnApiInternals::parseApiErrorResponse(ApiErrorResponse &error_response, std::string &json_data) {
-    try {
-#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-        json_spirit::mValue result;
-        json_spirit::read_string_or_throw(json_data, result);
+    reader.beginObject();
 
-        json_spirit::mObject &retObj = result.get_obj();
+    while (reader.nextMember(member)) {
+        if (member == "catenisNode") {
+            int ctnNodeIdx = 0;
+            std::string ctnNodeName;
+            std::string ctnNodeInfo;
+            bool has_index = false;
 
-        std::string const &status = retObj["status"].get_str();
-#elif defined(COM_SUPPORT_LIB_POCO)
-        Poco::JSON::Parser parser;
-        Poco::Dynamic::Var result = parser.parse(json_data);
+            reader.beginObject();
 
-        Poco::JSON::Object::Ptr retObj = result.extract<Poco::JSON::Object::Ptr>();
+            while (reader.nextMember(member)) {
+                if (member == "ctnNodeIndex") {
+                    ctnNodeIdx = reader.readInt();
+                    has_index = true;
+                }
+                else if (member == "name") {
+                    reader.readString(ctnNodeName);
+                }
+                else if (member == "description") {
+                    reader.readString(ctnNodeInfo);
+                }
+                else {
+                    reader.skipValue();
+                }
+            }
 
-        std::string status = retObj->getValue<std::string>("status");
-#endif
+            if (!has_index) throwUnexpectedData();
 
-        if (status == "error") {
-            error_response.status = status;
-#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
-            error_response.message = retObj["message"].get_str();
-#elif defined(COM_SUPPORT_LIB_POCO)
-            error_response.message = retObj->getValue<std::string>("message");
-#endif
-        } else {
-            throw CatenisClientError("Unexpected API error response");
+            data.catenisNode.reset(new ctn::CatenisNodeInfo(ctnNodeIdx, ctnNodeName, ctnNodeInfo));
+        }
+        else if (member == "client") {
+            std::string clientId;
+            std::string clientName;
+            bool has_client_id = false;
+
+            reader.beginObject();
+
+            while (reader.nextMember(member)) {
+                if (member == "clientId") {
+                    reader.readString(clientId);
+                    has_client_id = true;
+                }
+                else if (member == "name") {
+                    reader.readString(clientName);
+                }
+                else {
+                    reader.skipValue();
+                }
+            }
+
+            if (!has_client_id) throwUnexpectedData();
+
+            data.client.reset(new ctn::ClientInfo(clientId, clientName));
+        }
+        else if (member == "device") {
+            data.device = readDeviceInfo(reader);
+        }
+        else {
+            reader.skipValue();
         }
-    }
-    catch (...) {
-        throw CatenisClientError("Unexpected API error response");
     }
 }
 
 // Private Method.
 void ctn::CtnApiInternals::parseLogMessage(LogMessageResult &user_return_data, std::string json_data)
 {
+    LogMessageResult parsed_data;
+
+    if (this->streaming_json_parsing_ && readSuccessResponse(json_data, parsed_data, readMessageIdData<LogMessageResult>)) {
+        user_return_data = std::move(parsed_data);
+        return;
+    }
+
     try {
 #if defined(COM_SUPPORT_LIB_BOOST_ASIO)
         json_spirit::mValue result;
-        json_spirit::read_string_or_throw(json_data, result);
+        readJsonTree(json_data, result);
 
         json_spirit::mObject &retObj = result.get_obj();
 
@@ -455,10 +2210,17 @@ void ctn::CtnApiInternals::parseLogMessage(LogMessageResult &user_return_data, s
 // Private Method.
 void ctn::CtnApiInternals::parseSendMessage(SendMessageResult &user_return_data, std::string json_data)
 {
+    SendMessageResult parsed_data;
+
+    if (this->streaming_json_parsing_ && readSuccessResponse(json_data, parsed_data, readMessageIdData<SendMessageResult>)) {
+        user_return_data = std::move(parsed_data);
+        return;
+    }
+
     try {
 #if defined(COM_SUPPORT_LIB_BOOST_ASIO)
         json_spirit::mValue result;
-        json_spirit::read_string_or_throw(json_data, result);
+        readJsonTree(json_data, result);
 
         json_spirit::mObject &retObj = result.get_obj();
 
@@ -495,10 +2257,18 @@ void ctn::CtnApiInternals::parseSendMessage(SendMessageResult &user_return_data,
 // Private Method.
 void ctn::CtnApiInternals::parseReadMessage(ReadMessageResult &user_return_data, std::string json_data)
 {
+    ReadMessageResult parsed_data;
+
+    if (this->streaming_json_parsing_ && readSuccessResponse(json_data, parsed_data, readReadMessageData)) {
+        user_return_data = std::move(parsed_data);
+        internDevices(user_return_data);
+        return;
+    }
+
     try {
 #if defined(COM_SUPPORT_LIB_BOOST_ASIO)
         json_spirit::mValue result;
-        json_spirit::read_string_or_throw(json_data, result);
+        readJsonTree(json_data, result);
 
         json_spirit::mObject &retObj = result.get_obj();
 
@@ -578,15 +2348,38 @@ void ctn::CtnApiInternals::parseReadMessage(ReadMessageResult &user_return_data,
     catch(...) {
         throw CatenisClientError("Unexpected returned data from Read Message API method");
     }
+
+    internDevices(user_return_data);
+}
+
+// The returned data is kept by the view result, and always read in a single pass, since its string members refer to it
+void ctn::CtnApiInternals::parseReadMessageView(ReadMessageView &user_return_data, std::string json_data)
+{
+    ReadMessageView parsed_data;
+
+    parsed_data.body = std::make_shared<const std::string>(std::move(json_data));
+
+    if (!readSuccessResponse(*parsed_data.body, parsed_data, readReadMessageViewData)) {
+        throw CatenisClientError("Unexpected returned data from Read Message API method");
+    }
+
+    user_return_data = std::move(parsed_data);
 }
 
 // Private Method.
 void ctn::CtnApiInternals::parseRetrieveMessageContainer(RetrieveMessageContainerResult &user_return_data, std::string json_data)
 {
+    RetrieveMessageContainerResult parsed_data;
+
+    if (this->streaming_json_parsing_ && readSuccessResponse(json_data, parsed_data, readRetrieveMessageContainerData)) {
+        user_return_data = std::move(parsed_data);
+        return;
+    }
+
     try {
 #if defined(COM_SUPPORT_LIB_BOOST_ASIO)
         json_spirit::mValue result;
-        json_spirit::read_string_or_throw(json_data, result);
+        readJsonTree(json_data, result);
 
         json_spirit::mObject &retObj = result.get_obj();
 
@@ -662,10 +2455,20 @@ void ctn::CtnApiInternals::parseRetrieveMessageContainer(RetrieveMessageContaine
 // Private Method.
 void ctn::CtnApiInternals::parseListMessages(ListMessagesResult &user_return_data, std::string json_data)
 {
+    ListMessagesResult parsed_data;
+
+    if (this->streaming_json_parsing_ && readSuccessResponse(json_data, parsed_data, readListMessagesData)) {
+        user_return_data.messageList.splice(user_return_data.messageList.end(), parsed_data.messageList);
+        user_return_data.msgCount = parsed_data.msgCount;
+        user_return_data.countExceeded = parsed_data.countExceeded;
+        internDevices(user_return_data);
+        return;
+    }
+
     try {
 #if defined(COM_SUPPORT_LIB_BOOST_ASIO)
         json_spirit::mValue result;
-        json_spirit::read_string_or_throw(json_data, result);
+        readJsonTree(json_data, result);
 
         json_spirit::mObject &retObj = result.get_obj();
 
@@ -836,15 +2639,140 @@ void ctn::CtnApiInternals::parseListMessages(ListMessagesResult &user_return_dat
     catch(...) {
         throw CatenisClientError("Unexpected returned data from List Messages API method");
     }
+
+    internDevices(user_return_data);
+}
+
+void ctn::CtnApiInternals::parseListMessagesFlat(FlatListMessagesResult &user_return_data, std::string json_data)
+{
+    FlatListMessagesResult parsed_data;
+
+    if (this->streaming_json_parsing_ && readSuccessResponse(json_data, parsed_data, readFlatListMessagesData)) {
+        user_return_data = std::move(parsed_data);
+        return;
+    }
+
+    // Lay out the messages read into a document tree
+    ListMessagesResult list_data;
+    std::unordered_map<std::string, int> device_indices;
+
+    parseListMessages(list_data, std::move(json_data));
+
+    parsed_data.messages.reserve(list_data.messageList.size());
+
+    for (auto const &entry : list_data.messageList) {
+        FlatMessageDescription message;
+
+        message.messageId = entry->messageId;
+        message.action = entry->action;
+        message.direction = entry->direction;
+
+        if (entry->from) message.fromDevice = flatDeviceIndex(parsed_data, device_indices, entry->from->deviceId, entry->from->name, entry->from->prodUniqueId);
+        if (entry->to) message.toDevice = flatDeviceIndex(parsed_data, device_indices, entry->to->deviceId, entry->to->name, entry->to->prodUniqueId);
+
+        message.hasReadConfirmationEnabled = static_cast<bool>(entry->readConfirmationEnabled);
+        if (entry->readConfirmationEnabled) message.readConfirmationEnabled = *entry->readConfirmationEnabled;
+
+        message.hasRead = static_cast<bool>(entry->read);
+        if (entry->read) message.read = *entry->read;
+
+        message.date = entry->date;
+
+        parsed_data.messages.push_back(std::move(message));
+    }
+
+    parsed_data.msgCount = list_data.msgCount;
+    parsed_data.countExceeded = list_data.countExceeded;
+
+    user_return_data = std::move(parsed_data);
+}
+
+// Copy a value into a string held in a result arena
+static void copyToArena(const std::string &value, ctn::ArenaString &arena_value)
+{
+    arena_value.assign(value.data(), value.size());
+}
+
+static void copyToArena(const ctn::DeviceInfo &device, ctn::ArenaDeviceInfo &arena_device)
+{
+    copyToArena(device.deviceId, arena_device.deviceId);
+    copyToArena(device.name, arena_device.name);
+    copyToArena(device.prodUniqueId, arena_device.prodUniqueId);
+}
+
+void ctn::CtnApiInternals::parseListMessagesArena(ArenaListMessagesResult &user_return_data, std::string json_data)
+{
+    ResultArena &arena = user_return_data.arena();
+
+    user_return_data.messages.clear();
+
+    if (this->streaming_json_parsing_ && readSuccessResponse(json_data, user_return_data, readArenaListMessagesData)) return;
+
+    // Copy the messages read into a document tree
+    ListMessagesResult list_data;
+
+    parseListMessages(list_data, std::move(json_data));
+
+    user_return_data.messages.clear();
+    user_return_data.messages.reserve(list_data.messageList.size());
+
+    for (auto const &entry : list_data.messageList) {
+        user_return_data.messages.emplace_back(arena);
+
+        ArenaMessageDescription &message = user_return_data.messages.back();
+
+        copyToArena(entry->messageId, message.messageId);
+        copyToArena(entry->action, message.action);
+        copyToArena(entry->direction, message.direction);
+
+        message.hasFrom = static_cast<bool>(entry->from);
+        if (entry->from) copyToArena(*entry->from, message.from);
+
+        message.hasTo = static_cast<bool>(entry->to);
+        if (entry->to) copyToArena(*entry->to, message.to);
+
+        message.hasReadConfirmationEnabled = static_cast<bool>(entry->readConfirmationEnabled);
+        if (entry->readConfirmationEnabled) message.readConfirmationEnabled = *entry->readConfirmationEnabled;
+
+        message.hasRead = static_cast<bool>(entry->read);
+        if (entry->read) message.read = *entry->read;
+
+        copyToArena(entry->date, message.date);
+    }
+
+    user_return_data.msgCount = list_data.msgCount;
+    user_return_data.countExceeded = list_data.countExceeded;
+}
+
+void ctn::CtnApiInternals::parseListMessagesView(ListMessagesView &user_return_data, std::string json_data)
+{
+    ListMessagesView parsed_data;
+
+    parsed_data.body = std::make_shared<const std::string>(std::move(json_data));
+
+    if (!readSuccessResponse(*parsed_data.body, parsed_data, readListMessagesViewData)) {
+        throw CatenisClientError("Unexpected returned data from List Messages API method");
+    }
+
+    user_return_data = std::move(parsed_data);
 }
 
 // Private Method.
 void ctn::CtnApiInternals::parseListPermissionEvents(ListPermissionEventsResult &user_return_data, std::string json_data)
 {
+    ListPermissionEventsResult parsed_data;
+
+    if (this->streaming_json_parsing_ && readSuccessResponse(json_data, parsed_data, readListPermissionEventsData)) {
+        for (auto &entry : parsed_data.permissionEvents) {
+            user_return_data.permissionEvents[entry.first] = std::move(entry.second);
+        }
+        return;
+    }
+
     try {
 #if defined(COM_SUPPORT_LIB_BOOST_ASIO)
         json_spirit::mValue result;
-        json_spirit::read_string_or_throw(json_data, result);
+        readJsonTree(json_data, result);
 
         json_spirit::mObject &retObj = result.get_obj();
 
@@ -888,10 +2816,18 @@ void ctn::CtnApiInternals::parseListPermissionEvents(ListPermissionEventsResult
 // Private Method.
 void ctn::CtnApiInternals::parseRetrievePermissionRights(RetrievePermissionRightsResult &user_return_data, std::string json_data)
 {
+    RetrievePermissionRightsResult parsed_data;
+
+    if (this->streaming_json_parsing_ && readSuccessResponse(json_data, parsed_data, readRetrievePermissionRightsData)) {
+        user_return_data = std::move(parsed_data);
+        internDevices(user_return_data);
+        return;
+    }
+
     try {
 #if defined(COM_SUPPORT_LIB_BOOST_ASIO)
         json_spirit::mValue result;
-        json_spirit::read_string_or_throw(json_data, result);
+        readJsonTree(json_data, result);
 
         json_spirit::mObject &retObj = result.get_obj();
 
@@ -1163,15 +3099,90 @@ void ctn::CtnApiInternals::parseRetrievePermissionRights(RetrievePermissionRight
     catch (...) {
         throw CatenisClientError("Unexpected returned data from Retrieve Permission Rights API method");
     }
+
+    internDevices(user_return_data);
+}
+
+static void clearArenaResult(ctn::ArenaRetrievePermissionRightsResult &data)
+{
+    data.system.clear();
+    data.hasCatenisNode = data.hasClient = data.hasDevice = false;
+    data.catenisNode.allowed.clear();
+    data.catenisNode.denied.clear();
+    data.client.allowed.clear();
+    data.client.denied.clear();
+    data.device.allowed.clear();
+    data.device.denied.clear();
+}
+
+static void copyToArena(const std::list<std::string> &list, ctn::ArenaVector<ctn::ArenaString> &arena_list)
+{
+    arena_list.reserve(list.size());
+
+    for (auto const &entry : list) {
+        arena_list.emplace_back(ctn::ArenaAllocator<char>(arena_list.get_allocator()));
+        copyToArena(entry, arena_list.back());
+    }
+}
+
+static void copyToArena(const std::list< std::shared_ptr<ctn::DeviceInfo> > &list, ctn::ArenaVector<ctn::ArenaDeviceInfo> &arena_list)
+{
+    arena_list.reserve(list.size());
+
+    for (auto const &entry : list) {
+        arena_list.emplace_back(*arena_list.get_allocator().arena());
+        copyToArena(*entry, arena_list.back());
+    }
+}
+
+void ctn::CtnApiInternals::parseRetrievePermissionRightsArena(ArenaRetrievePermissionRightsResult &user_return_data, std::string json_data)
+{
+    clearArenaResult(user_return_data);
+
+    if (this->streaming_json_parsing_ && readSuccessResponse(json_data, user_return_data, readArenaRetrievePermissionRightsData)) return;
+
+    // Copy the permission rights read into a document tree
+    RetrievePermissionRightsResult rights_data;
+
+    parseRetrievePermissionRights(rights_data, std::move(json_data));
+
+    clearArenaResult(user_return_data);
+
+    copyToArena(rights_data.system, user_return_data.system);
+
+    if (rights_data.catenisNode) {
+        user_return_data.hasCatenisNode = true;
+        copyToArena(rights_data.catenisNode->allowed, user_return_data.catenisNode.allowed);
+        copyToArena(rights_data.catenisNode->denied, user_return_data.catenisNode.denied);
+    }
+
+    if (rights_data.client) {
+        user_return_data.hasClient = true;
+        copyToArena(rights_data.client->allowed, user_return_data.client.allowed);
+        copyToArena(rights_data.client->denied, user_return_data.client.denied);
+    }
+
+    if (rights_data.device) {
+        user_return_data.hasDevice = true;
+        copyToArena(rights_data.device->allowed, user_return_data.device.allowed);
+        copyToArena(rights_data.device->denied, user_return_data.device.denied);
+    }
 }
 
 // Private Method.
 void ctn::CtnApiInternals::parseSetPermissionRights(SetPermissionRightsResult &user_return_data, std::string json_data)
 {
+    SetPermissionRightsResult parsed_data;
+
+    if (this->streaming_json_parsing_ && readSuccessResponse(json_data, parsed_data, readSetPermissionRightsData)) {
+        user_return_data = std::move(parsed_data);
+        return;
+    }
+
     try {
 #if defined(COM_SUPPORT_LIB_BOOST_ASIO)
         json_spirit::mValue result;
-        json_spirit::read_string_or_throw(json_data, result);
+        readJsonTree(json_data, result);
 
         json_spirit::mObject &retObj = result.get_obj();
 
@@ -1207,10 +3218,19 @@ void ctn::CtnApiInternals::parseSetPermissionRights(SetPermissionRightsResult &u
 // Private Method.
 void ctn::CtnApiInternals::parseListNotificationEvents(ListNotificationEventsResult &user_return_data, std::string json_data)
 {
+    ListNotificationEventsResult parsed_data;
+
+    if (this->streaming_json_parsing_ && readSuccessResponse(json_data, parsed_data, readListNotificationEventsData)) {
+        for (auto &entry : parsed_data.notificationEvents) {
+            user_return_data.notificationEvents[entry.first] = std::move(entry.second);
+        }
+        return;
+    }
+
     try {
 #if defined(COM_SUPPORT_LIB_BOOST_ASIO)
         json_spirit::mValue result;
-        json_spirit::read_string_or_throw(json_data, result);
+        readJsonTree(json_data, result);
 
         json_spirit::mObject &retObj = result.get_obj();
 
@@ -1254,10 +3274,19 @@ void ctn::CtnApiInternals::parseListNotificationEvents(ListNotificationEventsRes
 // Private Method.
 void ctn::CtnApiInternals::parseCheckEffectivePermissionRight(CheckEffectivePermissionRightResult &user_return_data, std::string json_data)
 {
+    CheckEffectivePermissionRightResult parsed_data;
+
+    if (this->streaming_json_parsing_ && readSuccessResponse(json_data, parsed_data, readCheckEffectivePermissionRightData)) {
+        for (auto &entry : parsed_data.effectivePermissionRight) {
+            user_return_data.effectivePermissionRight[entry.first] = std::move(entry.second);
+        }
+        return;
+    }
+
     try {
 #if defined(COM_SUPPORT_LIB_BOOST_ASIO)
         json_spirit::mValue result;
-        json_spirit::read_string_or_throw(json_data, result);
+        readJsonTree(json_data, result);
 
         json_spirit::mObject &retObj = result.get_obj();
 
@@ -1301,10 +3330,17 @@ void ctn::CtnApiInternals::parseCheckEffectivePermissionRight(CheckEffectivePerm
 // Private Method.
 void ctn::CtnApiInternals::parseRetrieveDeviceIdInfo(DeviceIdInfoResult &user_return_data, std::string json_data)
 {
+    DeviceIdInfoResult parsed_data;
+
+    if (this->streaming_json_parsing_ && readSuccessResponse(json_data, parsed_data, readRetrieveDeviceIdInfoData)) {
+        user_return_data = std::move(parsed_data);
+        return;
+    }
+
     try {
 #if defined(COM_SUPPORT_LIB_BOOST_ASIO)
         json_spirit::mValue result;
-        json_spirit::read_string_or_throw(json_data, result);
+        readJsonTree(json_data, result);
 
         json_spirit::mObject &retObj = result.get_obj();
 
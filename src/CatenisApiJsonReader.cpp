@@ -0,0 +1,404 @@
+//
+//  CatenisApiJsonReader.cpp
+//  CatenisAPIClientCpp
+//
+
+#include <string>
+#include <climits>
+
+#include <CatenisApiException.h>
+#include <CatenisApiJsonReader.h>
+
+// Maximum nesting level of objects/arrays
+static const std::size_t MAX_JSON_DEPTH = 256;
+
+static void throwSyntaxError()
+{
+    throw ctn::CatenisClientError("Invalid JSON data");
+}
+
+// Constructor
+ctn::CtnApiJsonReader::CtnApiJsonReader(const char *data, std::size_t size)
+    : pos_(data), end_(data + size)
+{
+}
+
+void ctn::CtnApiJsonReader::skipWhitespace()
+{
+    while (this->pos_ < this->end_ && (*this->pos_ == ' ' || *this->pos_ == '\t' || *this->pos_ == '\n' || *this->pos_ == '\r')) {
+        this->pos_++;
+    }
+}
+
+// Get next non-whitespace character without consuming it
+char ctn::CtnApiJsonReader::nextChar()
+{
+    skipWhitespace();
+
+    if (this->pos_ == this->end_) throwSyntaxError();
+
+    return *this->pos_;
+}
+
+void ctn::CtnApiJsonReader::expect(char c)
+{
+    if (nextChar() != c) throwSyntaxError();
+
+    this->pos_++;
+}
+
+void ctn::CtnApiJsonReader::expectLiteral(const char *literal)
+{
+    for (; *literal != '\0'; literal++, this->pos_++) {
+        if (this->pos_ == this->end_ || *this->pos_ != *literal) throwSyntaxError();
+    }
+}
+
+ctn::CtnApiJsonReader::ValueType ctn::CtnApiJsonReader::peek()
+{
+    switch (nextChar()) {
+        case '{':
+            return ObjectValue;
+
+        case '[':
+            return ArrayValue;
+
+        case '"':
+            return StringValue;
+
+        case 't':
+        case 'f':
+            return BoolValue;
+
+        case 'n':
+            return NullValue;
+
+        case '-':
+        case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+            return NumberValue;
+
+        default:
+            throwSyntaxError();
+    }
+
+    return NullValue;
+}
+
+void ctn::CtnApiJsonReader::beginObject()
+{
+    expect('{');
+
+    if (this->has_values_.size() >= MAX_JSON_DEPTH) throwSyntaxError();
+    this->has_values_.push_back(false);
+}
+
+void ctn::CtnApiJsonReader::beginArray()
+{
+    expect('[');
+
+    if (this->has_values_.size() >= MAX_JSON_DEPTH) throwSyntaxError();
+    this->has_values_.push_back(false);
+}
+
+// Move past separator that precedes the next item of the object/array being read, or past its closing character
+bool ctn::CtnApiJsonReader::nextItem(char closing)
+{
+    if (this->has_values_.empty()) throwSyntaxError();
+
+    if (nextChar() == closing) {
+        this->pos_++;
+        this->has_values_.pop_back();
+
+        return false;
+    }
+
+    if (this->has_values_.back()) {
+        expect(',');
+    }
+    else {
+        this->has_values_.back() = true;
+    }
+
+    return true;
+}
+
+bool ctn::CtnApiJsonReader::nextMember(std::string &name)
+{
+    if (!nextItem('}')) return false;
+
+    readString(name);
+    expect(':');
+
+    return true;
+}
+
+bool ctn::CtnApiJsonReader::nextElement()
+{
+    return nextItem(']');
+}
+
+unsigned int ctn::CtnApiJsonReader::readHex4()
+{
+    unsigned int code = 0;
+
+    for (int idx = 0; idx < 4; idx++, this->pos_++) {
+        if (this->pos_ == this->end_) throwSyntaxError();
+
+        char c = *this->pos_;
+        code <<= 4;
+
+        if (c >= '0' && c <= '9') code |= c - '0';
+        else if (c >= 'a' && c <= 'f') code |= c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') code |= c - 'A' + 10;
+        else throwSyntaxError();
+    }
+
+    return code;
+}
+
+// Decode \uXXXX escape sequence (the "\u" part having already been consumed) into UTF-8
+void ctn::CtnApiJsonReader::readUnicodeEscape(std::string &value)
+{
+    unsigned int code = readHex4();
+
+    if (code >= 0xD800 && code <= 0xDBFF) {
+        // High surrogate: must be followed by the low surrogate of the pair
+        if (this->end_ - this->pos_ < 6 || this->pos_[0] != '\\' || this->pos_[1] != 'u') throwSyntaxError();
+        this->pos_ += 2;
+
+        unsigned int low = readHex4();
+        if (low < 0xDC00 || low > 0xDFFF) throwSyntaxError();
+
+        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+    }
+    else if (code >= 0xDC00 && code <= 0xDFFF) {
+        throwSyntaxError();
+    }
+
+    if (code < 0x80) {
+        value += (char)code;
+    }
+    else if (code < 0x800) {
+        value += (char)(0xC0 | (code >> 6));
+        value += (char)(0x80 | (code & 0x3F));
+    }
+    else if (code < 0x10000) {
+        value += (char)(0xE0 | (code >> 12));
+        value += (char)(0x80 | ((code >> 6) & 0x3F));
+        value += (char)(0x80 | (code & 0x3F));
+    }
+    else {
+        value += (char)(0xF0 | (code >> 18));
+        value += (char)(0x80 | ((code >> 12) & 0x3F));
+        value += (char)(0x80 | ((code >> 6) & 0x3F));
+        value += (char)(0x80 | (code & 0x3F));
+    }
+}
+
+// Read contents of string, the opening quote having already been consumed
+void ctn::CtnApiJsonReader::readStringContent(std::string &value)
+{
+    value.clear();
+
+    for (;;) {
+        // Copy run of characters that need no unescaping in one go
+        const char *run = this->pos_;
+
+        while (this->pos_ < this->end_ && *this->pos_ != '"' && *this->pos_ != '\\' && (unsigned char)*this->pos_ >= 0x20) {
+            this->pos_++;
+        }
+
+        value.append(run, this->pos_ - run);
+
+        if (this->pos_ == this->end_) throwSyntaxError();
+
+        char c = *this->pos_++;
+
+        if (c == '"') return;
+
+        if (c != '\\' || this->pos_ == this->end_) throwSyntaxError();
+
+        switch (*this->pos_++) {
+            case '"': value += '"'; break;
+            case '\\': value += '\\'; break;
+            case '/': value += '/'; break;
+            case 'b': value += '\b'; break;
+            case 'f': value += '\f'; break;
+            case 'n': value += '\n'; break;
+            case 'r': value += '\r'; break;
+            case 't': value += '\t'; break;
+            case 'u': readUnicodeEscape(value); break;
+            default: throwSyntaxError();
+        }
+    }
+}
+
+void ctn::CtnApiJsonReader::readString(std::string &value)
+{
+    expect('"');
+    readStringContent(value);
+}
+
+void ctn::CtnApiJsonReader::readRawString(const char *&data, std::size_t &size, bool &escaped)
+{
+    expect('"');
+
+    data = this->pos_;
+    escaped = false;
+
+    for (;;) {
+        if (this->pos_ == this->end_ || (unsigned char)*this->pos_ < 0x20) throwSyntaxError();
+
+        char c = *this->pos_++;
+
+        if (c == '"') break;
+
+        if (c == '\\') {
+            // Escape sequences are only checked here. They are decoded if the string is ever unescaped
+            if (this->pos_ == this->end_) throwSyntaxError();
+
+            escaped = true;
+
+            switch (*this->pos_++) {
+                case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't': break;
+                case 'u': readHex4(); break;
+                default: throwSyntaxError();
+            }
+        }
+    }
+
+    size = this->pos_ - 1 - data;
+}
+
+std::string ctn::CtnApiJsonReader::unescape(const char *data, std::size_t size)
+{
+    std::string quoted(data, size);
+    std::string value;
+
+    quoted += '"';
+
+    CtnApiJsonReader reader(quoted);
+    reader.readStringContent(value);
+
+    return value;
+}
+
+std::string ctn::CtnApiJsonReader::readString()
+{
+    std::string value;
+    readString(value);
+
+    return value;
+}
+
+bool ctn::CtnApiJsonReader::readBool()
+{
+    if (nextChar() == 't') {
+        expectLiteral("true");
+        return true;
+    }
+
+    expectLiteral("false");
+    return false;
+}
+
+int ctn::CtnApiJsonReader::readInt()
+{
+    bool negative = false;
+
+    if (nextChar() == '-') {
+        negative = true;
+        this->pos_++;
+    }
+
+    if (this->pos_ == this->end_ || *this->pos_ < '0' || *this->pos_ > '9') throwSyntaxError();
+
+    // Leading zeros are not allowed
+    if (*this->pos_ == '0' && this->pos_ + 1 < this->end_ && this->pos_[1] >= '0' && this->pos_[1] <= '9') throwSyntaxError();
+
+    long long value = 0;
+
+    while (this->pos_ < this->end_ && *this->pos_ >= '0' && *this->pos_ <= '9') {
+        value = value * 10 + (*this->pos_++ - '0');
+
+        if (value > (long long)INT_MAX + 1) throwSyntaxError();
+    }
+
+    // Only integral numbers are accepted
+    if (this->pos_ < this->end_ && (*this->pos_ == '.' || *this->pos_ == 'e' || *this->pos_ == 'E')) throwSyntaxError();
+
+    if (negative) value = -value;
+    if (value > INT_MAX) throwSyntaxError();
+
+    return (int)value;
+}
+
+void ctn::CtnApiJsonReader::readNull()
+{
+    nextChar();
+    expectLiteral("null");
+}
+
+void ctn::CtnApiJsonReader::skipNumber()
+{
+    if (*this->pos_ == '-') this->pos_++;
+
+    const char *digits = this->pos_;
+    while (this->pos_ < this->end_ && *this->pos_ >= '0' && *this->pos_ <= '9') this->pos_++;
+    if (this->pos_ == digits || (*digits == '0' && this->pos_ - digits > 1)) throwSyntaxError();
+
+    if (this->pos_ < this->end_ && *this->pos_ == '.') {
+        digits = ++this->pos_;
+        while (this->pos_ < this->end_ && *this->pos_ >= '0' && *this->pos_ <= '9') this->pos_++;
+        if (this->pos_ == digits) throwSyntaxError();
+    }
+
+    if (this->pos_ < this->end_ && (*this->pos_ == 'e' || *this->pos_ == 'E')) {
+        this->pos_++;
+        if (this->pos_ < this->end_ && (*this->pos_ == '+' || *this->pos_ == '-')) this->pos_++;
+        digits = this->pos_;
+        while (this->pos_ < this->end_ && *this->pos_ >= '0' && *this->pos_ <= '9') this->pos_++;
+        if (this->pos_ == digits) throwSyntaxError();
+    }
+}
+
+void ctn::CtnApiJsonReader::skipValue()
+{
+    std::string scratch;
+
+    switch (peek()) {
+        case ObjectValue:
+            beginObject();
+            while (nextMember(scratch)) skipValue();
+            break;
+
+        case ArrayValue:
+            beginArray();
+            while (nextElement()) skipValue();
+            break;
+
+        case StringValue:
+            readString(scratch);
+            break;
+
+        case BoolValue:
+            readBool();
+            break;
+
+        case NullValue:
+            readNull();
+            break;
+
+        case NumberValue:
+            skipNumber();
+            break;
+    }
+}
+
+void ctn::CtnApiJsonReader::end()
+{
+    skipWhitespace();
+
+    if (this->pos_ != this->end_ || !this->has_values_.empty()) throwSyntaxError();
+}
@@ -0,0 +1,143 @@
+//
+//  CatenisApiJsonWriter.cpp
+//  CatenisAPIClientCpp
+//
+
+#include <string>
+
+#include <CatenisApiException.h>
+#include <CatenisApiJsonWriter.h>
+
+// Maximum nesting level of objects/arrays (one bit of each level mask per level)
+static const unsigned int MAX_JSON_DEPTH = 64;
+
+static const char HEX_DIGITS[] = "0123456789abcdef";
+
+// Characters that the escaped form of the given character takes (1 if it needs no escaping)
+static inline std::size_t escapedLength(unsigned char c)
+{
+    if (c == '"' || c == '\\') return 2;
+
+    if (c < 0x20) {
+        return c == '\b' || c == '\f' || c == '\n' || c == '\r' || c == '\t' ? 2 : 6;
+    }
+
+    return 1;
+}
+
+static inline unsigned long long levelBit(unsigned int depth)
+{
+    return 1ULL << (depth - 1);
+}
+
+// Write separator that precedes array elements
+void ctn::CtnApiJsonWriter::beginValue()
+{
+    if (this->depth_ > 0 && (this->arrays_ & levelBit(this->depth_))) {
+        if (this->has_values_ & levelBit(this->depth_)) {
+            this->out_ += ',';
+        }
+        else {
+            this->has_values_ |= levelBit(this->depth_);
+        }
+    }
+}
+
+void ctn::CtnApiJsonWriter::beginContainer(char opening, bool is_array)
+{
+    if (this->depth_ >= MAX_JSON_DEPTH) throw CatenisClientError("JSON data nested too deeply");
+
+    beginValue();
+    this->out_ += opening;
+
+    this->depth_++;
+    this->has_values_ &= ~levelBit(this->depth_);
+
+    if (is_array) {
+        this->arrays_ |= levelBit(this->depth_);
+    }
+    else {
+        this->arrays_ &= ~levelBit(this->depth_);
+    }
+}
+
+void ctn::CtnApiJsonWriter::endContainer(char closing)
+{
+    this->out_ += closing;
+    this->depth_--;
+}
+
+ctn::CtnApiJsonWriter &ctn::CtnApiJsonWriter::member(const char *name)
+{
+    if (this->has_values_ & levelBit(this->depth_)) {
+        this->out_ += ',';
+    }
+    else {
+        this->has_values_ |= levelBit(this->depth_);
+    }
+
+    this->out_ += '"';
+    this->out_ += name;
+    this->out_ += "\":";
+
+    return *this;
+}
+
+ctn::CtnApiJsonWriter &ctn::CtnApiJsonWriter::value(const std::string &value)
+{
+    beginValue();
+    this->out_ += '"';
+
+    const char *pos = value.data();
+    const char *end = pos + value.size();
+
+    while (pos < end) {
+        // Copy run of characters that need no escaping in one go
+        const char *run = pos;
+
+        while (pos < end && escapedLength((unsigned char)*pos) == 1) pos++;
+
+        this->out_.append(run, pos - run);
+
+        if (pos == end) break;
+
+        unsigned char c = (unsigned char)*pos++;
+
+        switch (c) {
+            case '"': this->out_ += "\\\""; break;
+            case '\\': this->out_ += "\\\\"; break;
+            case '\b': this->out_ += "\\b"; break;
+            case '\f': this->out_ += "\\f"; break;
+            case '\n': this->out_ += "\\n"; break;
+            case '\r': this->out_ += "\\r"; break;
+            case '\t': this->out_ += "\\t"; break;
+            default: {
+                char esc[] = {'\\', 'u', '0', '0', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 0x0F]};
+                this->out_.append(esc, sizeof esc);
+            }
+        }
+    }
+
+    this->out_ += '"';
+
+    return *this;
+}
+
+ctn::CtnApiJsonWriter &ctn::CtnApiJsonWriter::value(bool value)
+{
+    beginValue();
+    this->out_ += value ? "true" : "false";
+
+    return *this;
+}
+
+std::size_t ctn::CtnApiJsonWriter::quotedSize(const std::string &value)
+{
+    std::size_t size = value.size() + 2;
+
+    for (std::string::const_iterator it = value.begin(); it != value.end(); ++it) {
+        size += escapedLength((unsigned char)*it) - 1;
+    }
+
+    return size;
+}
@@ -0,0 +1,212 @@
+//
+//  CatenisApiResolver.cpp
+//  CatenisAPIClientCpp
+//
+
+#include <memory>
+#include <utility>
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+#include <boost/asio/error.hpp>
+#elif defined(COM_SUPPORT_LIB_POCO)
+#include <Poco/Net/DNS.h>
+#include <Poco/Net/HostEntry.h>
+#include <Poco/Net/IPAddress.h>
+#include <Poco/Exception.h>
+#endif
+
+#include <CatenisApiResolver.h>
+#include <CatenisApiExecutor.h>
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+using boost::asio::ip::tcp;
+#endif
+
+// Constructor
+ctn::CtnApiResolver::CtnApiResolver(CtnApiExecutor &executor, unsigned int ttl)
+    : executor_(executor), ttl_(ttl)
+{
+}
+
+// Addresses starting at the next one to be used, which is then moved ahead
+std::vector<ctn::CtnApiResolver::Endpoint> ctn::CtnApiResolver::Entry::rotatedEndpoints()
+{
+    std::vector<Endpoint> rotated;
+
+    rotated.reserve(endpoints.size());
+
+    for (std::size_t idx = 0; idx < endpoints.size(); idx++) {
+        rotated.push_back(endpoints[(next + idx) % endpoints.size()]);
+    }
+
+    if (!endpoints.empty()) next = (next + 1) % endpoints.size();
+
+    return rotated;
+}
+
+bool ctn::CtnApiResolver::isCached(const Entry &entry) const
+{
+    return ttl_.count() > 0 && !entry.endpoints.empty();
+}
+
+bool ctn::CtnApiResolver::needsRefresh(const Entry &entry, std::chrono::steady_clock::time_point now) const
+{
+    return !entry.resolving && now - entry.resolvedAt >= ttl_;
+}
+
+#if defined(COM_SUPPORT_LIB_BOOST_ASIO)
+void ctn::CtnApiResolver::resolveAsync(const std::string &host, const std::string &port, ResolveHandler handler)
+{
+    std::string key = host + ":" + port;
+    std::unique_lock<std::mutex> lock(mutex_);
+    Entry &entry = entries_[key];
+
+    if (isCached(entry)) {
+        bool refresh = needsRefresh(entry, std::chrono::steady_clock::now());
+
+        if (refresh) entry.resolving = true;
+
+        std::vector<Endpoint> endpoints = entry.rotatedEndpoints();
+        lock.unlock();
+
+        // Stale addresses are still used while they are looked up again
+        if (refresh) startLookup(key, host, port);
+
+        handler(boost::system::error_code(), std::move(endpoints));
+        return;
+    }
+
+    // Addresses not available yet. Wait for the lookup in progress, if any
+    entry.waiters.push_back(handler);
+
+    if (!entry.resolving) {
+        entry.resolving = true;
+        lock.unlock();
+
+        startLookup(key, host, port);
+    }
+}
+
+void ctn::CtnApiResolver::startLookup(const std::string &key, const std::string &host, const std::string &port)
+{
+    std::shared_ptr<tcp::resolver> resolver(new tcp::resolver(executor_.ioContext()));
+
+    resolver->async_resolve(host, port, [this, resolver, key](const boost::system::error_code &ec, tcp::resolver::results_type results) {
+        std::list<ResolveHandler> waiters;
+        std::vector<Endpoint> endpoints;
+        boost::system::error_code error = ec;
+
+        if (!error && results.empty()) error = boost::asio::error::host_not_found;
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            auto it = this->entries_.find(key);
+
+            if (it == this->entries_.end()) return;
+
+            Entry &entry = it->second;
+
+            entry.resolving = false;
+            waiters.swap(entry.waiters);
+
+            if (!error) {
+                entry.endpoints.clear();
+
+                for (auto const &result : results) {
+                    entry.endpoints.push_back(result.endpoint());
+                }
+
+                entry.resolvedAt = std::chrono::steady_clock::now();
+                entry.next = 0;
+            }
+
+            // A failed refresh keeps the stale addresses, which are looked up again on their next use
+            if (!error && !waiters.empty()) endpoints = entry.rotatedEndpoints();
+
+            if (this->ttl_.count() == 0 || entry.endpoints.empty()) this->entries_.erase(it);
+        }
+
+        // Waiters share the same rotation, since they have all been waiting for the same lookup
+        for (auto &waiter : waiters) {
+            waiter(error, endpoints);
+        }
+    });
+}
+#elif defined(COM_SUPPORT_LIB_POCO)
+std::vector<ctn::CtnApiResolver::Endpoint> ctn::CtnApiResolver::resolve(const std::string &host, const std::string &port)
+{
+    std::string key = host + ":" + port;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Entry &entry = entries_[key];
+
+        if (isCached(entry)) {
+            if (needsRefresh(entry, std::chrono::steady_clock::now())) {
+                // Stale addresses are still used while they are looked up again by one of the executor's threads
+                entry.resolving = true;
+                executor_.post([this, key, host, port]() {
+                    this->refresh(key, host, port);
+                });
+            }
+
+            return entry.rotatedEndpoints();
+        }
+    }
+
+    // Addresses not available yet. Look them up outside the lock
+    std::vector<Endpoint> endpoints = lookup(host, port);
+
+    if (ttl_.count() == 0) return endpoints;
+
+    storeEndpoints(key, std::move(endpoints));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    return entries_[key].rotatedEndpoints();
+}
+
+std::vector<ctn::CtnApiResolver::Endpoint> ctn::CtnApiResolver::lookup(const std::string &host, const std::string &port)
+{
+    Poco::UInt16 port_number = static_cast<Poco::UInt16>(std::stoi(port));
+    std::vector<Endpoint> endpoints;
+    Poco::Net::IPAddress address;
+
+    if (Poco::Net::IPAddress::tryParse(host, address)) {
+        endpoints.push_back(Endpoint(address, port_number));
+    }
+    else {
+        for (auto const &host_address : Poco::Net::DNS::resolve(host).addresses()) {
+            endpoints.push_back(Endpoint(host_address, port_number));
+        }
+    }
+
+    if (endpoints.empty()) throw Poco::Net::HostNotFoundException(host);
+
+    return endpoints;
+}
+
+void ctn::CtnApiResolver::storeEndpoints(const std::string &key, std::vector<Endpoint> endpoints)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry &entry = entries_[key];
+
+    entry.endpoints = std::move(endpoints);
+    entry.resolvedAt = std::chrono::steady_clock::now();
+    entry.next = 0;
+    entry.resolving = false;
+}
+
+void ctn::CtnApiResolver::refresh(const std::string &key, const std::string &host, const std::string &port)
+{
+    try {
+        storeEndpoints(key, lookup(host, port));
+    }
+    catch (...) {
+        // Keep the stale addresses, which are looked up again on their next use
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        entries_[key].resolving = false;
+    }
+}
+#endif
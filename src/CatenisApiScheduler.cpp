@@ -0,0 +1,200 @@
+//
+//  CatenisApiScheduler.cpp
+//  CatenisAPIClientCpp
+//
+
+#include <cmath>
+#include <future>
+#include <utility>
+#include <algorithm>
+
+#include <CatenisApiScheduler.h>
+#include <CatenisApiExecutor.h>
+
+// Constructor
+ctn::CtnApiScheduler::CtnApiScheduler(CtnApiExecutor &executor, const SchedulerOptions &options)
+    : executor_(executor), options_(options), in_flight_(0), wakeup_pending_(false), peak_queue_depth_(0), queued_requests_(0)
+{
+    burst_ = options_.burst > 0 ? options_.burst : std::max(1.0, std::ceil(options_.requestsPerSecond));
+
+    // Start with a full bucket
+    tokens_ = burst_;
+    last_refill_ = std::chrono::steady_clock::now();
+}
+
+bool ctn::CtnApiScheduler::enabled() const
+{
+    return options_.requestsPerSecond > 0 || options_.maxConcurrent > 0;
+}
+
+void ctn::CtnApiScheduler::schedule(RequestPriority priority, Task task, std::chrono::steady_clock::time_point deadline, Task expire)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::deque<QueuedRequest> &queue = queues_[static_cast<std::size_t>(priority)];
+    std::vector<Task> ready;
+
+    queue.emplace_back(task, expire, deadline);
+    dispatch(ready);
+
+    // Requests of the same priority are admitted in order, so the request is still queued if its queue is not empty
+    if (!queue.empty()) {
+        queued_requests_++;
+        peak_queue_depth_ = std::max<unsigned long>(peak_queue_depth_, queueDepth());
+
+        if (deadline != std::chrono::steady_clock::time_point::max()) scheduleExpiry(deadline);
+    }
+
+    scheduleWakeup();
+    lock.unlock();
+
+    for (auto &ready_task : ready) {
+        ready_task();
+    }
+}
+
+bool ctn::CtnApiScheduler::acquire(RequestPriority priority, std::chrono::steady_clock::time_point deadline)
+{
+    std::promise<bool> admitted;
+    std::future<bool> done = admitted.get_future();
+
+    schedule(priority, [&admitted]() {
+        admitted.set_value(true);
+    }, deadline, [&admitted]() {
+        admitted.set_value(false);
+    });
+
+    return done.get();
+}
+
+void ctn::CtnApiScheduler::release()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    in_flight_--;
+
+    admitQueued(lock);
+}
+
+ctn::SchedulerStats ctn::CtnApiScheduler::stats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    SchedulerStats stats;
+
+    stats.readQueueDepth = queues_[static_cast<std::size_t>(RequestPriority::read)].size();
+    stats.writeQueueDepth = queues_[static_cast<std::size_t>(RequestPriority::write)].size();
+    stats.bulkQueueDepth = queues_[static_cast<std::size_t>(RequestPriority::bulk)].size();
+    stats.queueDepth = queueDepth();
+    stats.peakQueueDepth = peak_queue_depth_;
+    stats.inFlight = in_flight_;
+    stats.queuedRequests = queued_requests_;
+
+    return stats;
+}
+
+std::size_t ctn::CtnApiScheduler::queueDepth() const
+{
+    std::size_t depth = 0;
+
+    for (auto const &queue : queues_) {
+        depth += queue.size();
+    }
+
+    return depth;
+}
+
+// Add the tokens earned since the last refill
+void ctn::CtnApiScheduler::refill(std::chrono::steady_clock::time_point now)
+{
+    if (options_.requestsPerSecond > 0) {
+        std::chrono::duration<double> elapsed = now - last_refill_;
+
+        tokens_ = std::min(burst_, tokens_ + elapsed.count() * options_.requestsPerSecond);
+    }
+
+    last_refill_ = now;
+}
+
+// Remove the queued requests whose deadline has passed, and get their expire tasks
+void ctn::CtnApiScheduler::dropExpired(std::chrono::steady_clock::time_point now, std::vector<Task> &expired)
+{
+    for (auto &queue : queues_) {
+        for (auto it = queue.begin(); it != queue.end();) {
+            if (it->deadline <= now) {
+                if (it->expire) expired.push_back(std::move(it->expire));
+                it = queue.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+}
+
+// Admit queued requests, highest priority first, while the limits allow it. Expired requests are dropped, and their
+//  expire tasks are returned along with the tasks of the admitted requests
+void ctn::CtnApiScheduler::dispatch(std::vector<Task> &ready)
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    dropExpired(now, ready);
+    refill(now);
+
+    for (auto &queue : queues_) {
+        while (!queue.empty()) {
+            if (options_.maxConcurrent > 0 && in_flight_ >= options_.maxConcurrent) return;
+            if (options_.requestsPerSecond > 0 && tokens_ < 1.0) return;
+
+            if (options_.requestsPerSecond > 0) tokens_ -= 1.0;
+            in_flight_++;
+
+            ready.push_back(std::move(queue.front().task));
+            queue.pop_front();
+        }
+    }
+}
+
+// Have queued requests admitted when the next token is added, unless they are waiting for requests to complete
+void ctn::CtnApiScheduler::scheduleWakeup()
+{
+    if (wakeup_pending_ || queueDepth() == 0 || options_.requestsPerSecond <= 0 || tokens_ >= 1.0) return;
+    if (options_.maxConcurrent > 0 && in_flight_ >= options_.maxConcurrent) return;
+
+    std::chrono::milliseconds delay(static_cast<long>(std::ceil((1.0 - tokens_) * 1000 / options_.requestsPerSecond)));
+
+    wakeup_pending_ = true;
+
+    executor_.postAfter(delay, [this]() {
+        std::unique_lock<std::mutex> lock(this->mutex_);
+
+        this->wakeup_pending_ = false;
+        this->admitQueued(lock);
+    });
+}
+
+// Drop the queued requests whose deadline has passed once it is reached
+void ctn::CtnApiScheduler::scheduleExpiry(std::chrono::steady_clock::time_point deadline)
+{
+    // Rounded up, so the deadline has passed when the check is made
+    std::chrono::milliseconds delay = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now())
+            + std::chrono::milliseconds(1);
+
+    executor_.postAfter(std::max(delay, std::chrono::milliseconds(0)), [this]() {
+        std::unique_lock<std::mutex> lock(this->mutex_);
+
+        this->admitQueued(lock);
+    });
+}
+
+// Admit queued requests, and run their tasks outside the lock
+void ctn::CtnApiScheduler::admitQueued(std::unique_lock<std::mutex> &lock)
+{
+    std::vector<Task> ready;
+
+    dispatch(ready);
+    scheduleWakeup();
+    lock.unlock();
+
+    for (auto &task : ready) {
+        task();
+    }
+}
@@ -0,0 +1,156 @@
+//
+//  CatenisApiSigningKey.cpp
+//  CatenisAPIClientCpp
+//
+
+#include <string>
+#include <ctime>
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#endif
+
+#include <CatenisApiException.h>
+#include <CatenisApiInternals.h>
+#include <CatenisApiSigningKey.h>
+#include <CatenisApiUtils.h>
+
+// Single pass HMAC-SHA256
+static std::string hmacSha256(const std::string &key, const std::string &data)
+{
+    unsigned char raw[EVP_MAX_MD_SIZE];
+    unsigned int len;
+
+    if (HMAC(EVP_sha256(), key.data(), (int)key.length(), (const unsigned char *)data.data(), data.length(), raw, &len) == NULL) {
+        throw ctn::CatenisClientError("Error deriving request signing key");
+    }
+
+    return std::string((char *)raw, (std::string::size_type)len);
+}
+
+// Constructor
+ctn::CtnApiSigningKey::CtnApiSigningKey(const std::string &api_access_secret, time_t date)
+    : date_(date), hmac_ctx_(NULL)
+{
+    char date_buffer[9];
+    struct tm date_tm;
+
+#ifdef _WIN32
+    gmtime_s(&date_tm, &date);
+#else
+    gmtime_r(&date, &date_tm);
+#endif
+    strftime(date_buffer, sizeof date_buffer, "%Y%m%d", &date_tm);
+    this->signdate_ = std::string(date_buffer);
+
+    std::string datekey = hmacSha256(SIGN_VERSION_ID + api_access_secret, this->signdate_);
+    std::string signkey = hmacSha256(datekey, SCOPE_REQUEST);
+
+    // Key the HMAC context once. It is copied for every request signed with this key
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    EVP_MAC *mac = EVP_MAC_fetch(NULL, "HMAC", NULL);
+
+    if (mac != NULL) {
+        this->hmac_ctx_ = EVP_MAC_CTX_new(mac);
+        EVP_MAC_free(mac);
+    }
+
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, (char *)"SHA256", 0),
+        OSSL_PARAM_construct_end()
+    };
+    bool success = this->hmac_ctx_ != NULL
+            && EVP_MAC_init(this->hmac_ctx_, (const unsigned char *)signkey.data(), signkey.length(), params) == 1;
+#elif OPENSSL_VERSION_NUMBER >= 0x10100000L
+    this->hmac_ctx_ = HMAC_CTX_new();
+
+    bool success = this->hmac_ctx_ != NULL
+            && HMAC_Init_ex(this->hmac_ctx_, signkey.data(), (int)signkey.length(), EVP_sha256(), NULL) == 1;
+#else
+    this->hmac_ctx_ = new HMAC_CTX;
+    HMAC_CTX_init(this->hmac_ctx_);
+
+    bool success = HMAC_Init_ex(this->hmac_ctx_, signkey.data(), (int)signkey.length(), EVP_sha256(), NULL) == 1;
+#endif
+
+    if (!success) {
+        freeContext();
+        throw CatenisClientError("Error deriving request signing key");
+    }
+}
+
+// Destructor
+ctn::CtnApiSigningKey::~CtnApiSigningKey()
+{
+    freeContext();
+}
+
+void ctn::CtnApiSigningKey::freeContext()
+{
+    if (this->hmac_ctx_ == NULL) return;
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    EVP_MAC_CTX_free(this->hmac_ctx_);
+#elif OPENSSL_VERSION_NUMBER >= 0x10100000L
+    HMAC_CTX_free(this->hmac_ctx_);
+#else
+    HMAC_CTX_cleanup(this->hmac_ctx_);
+    delete this->hmac_ctx_;
+#endif
+    this->hmac_ctx_ = NULL;
+}
+
+bool ctn::CtnApiSigningKey::isValidAt(time_t now) const
+{
+    return std::difftime(now, this->date_)/(3600 * 24) < SIGN_VALID_DAYS;
+}
+
+std::string ctn::CtnApiSigningKey::sign(const std::string &data) const
+{
+    unsigned char raw[EVP_MAX_MD_SIZE];
+    bool success;
+
+    // The keyed context is shared, so work on a copy of it
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    size_t len = 0;
+    EVP_MAC_CTX *ctx = EVP_MAC_CTX_dup(this->hmac_ctx_);
+
+    success = ctx != NULL
+            && EVP_MAC_update(ctx, (const unsigned char *)data.data(), data.length()) == 1
+            && EVP_MAC_final(ctx, raw, &len, sizeof raw) == 1;
+
+    EVP_MAC_CTX_free(ctx);
+#elif OPENSSL_VERSION_NUMBER >= 0x10100000L
+    unsigned int len = 0;
+    HMAC_CTX *ctx = HMAC_CTX_new();
+
+    success = ctx != NULL
+            && HMAC_CTX_copy(ctx, this->hmac_ctx_) == 1
+            && HMAC_Update(ctx, (const unsigned char *)data.data(), data.length()) == 1
+            && HMAC_Final(ctx, raw, &len) == 1;
+
+    HMAC_CTX_free(ctx);
+#else
+    unsigned int len = 0;
+    HMAC_CTX ctx;
+    HMAC_CTX_init(&ctx);
+
+    success = HMAC_CTX_copy(&ctx, this->hmac_ctx_) == 1
+            && HMAC_Update(&ctx, (const unsigned char *)data.data(), data.length()) == 1
+            && HMAC_Final(&ctx, raw, &len) == 1;
+
+    HMAC_CTX_cleanup(&ctx);
+#endif
+
+    if (!success) {
+        throw CatenisClientError("Error signing request");
+    }
+
+    char hex_signature[2 * EVP_MAX_MD_SIZE];
+    hexEncode(raw, len, hex_signature);
+
+    return std::string(hex_signature, 2 * len);
+}
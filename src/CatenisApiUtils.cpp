@@ -0,0 +1,66 @@
+//
+//  CatenisApiUtils.cpp
+//  CatenisAPIClientCpp
+//
+
+#include <string>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CTN_HEX_ENCODE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include <CatenisApiUtils.h>
+
+// Hex digits of every byte value
+static const char HEX_PAIRS[] =
+    "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+    "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+    "404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+    "606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+    "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+    "a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+    "c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+    "e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+void ctn::hexEncode(const unsigned char *data, std::size_t size, char *out)
+{
+    std::size_t idx = 0;
+
+#if defined(CTN_HEX_ENCODE_SSE2)
+    // Encode 16 bytes at a time: split each byte into its two nibbles, and turn every nibble into its digit
+    //  ('0' + nibble, plus the distance from '9' + 1 to 'a' when the nibble is greater than 9)
+    const __m128i low_mask = _mm_set1_epi8(0x0f);
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i zero_char = _mm_set1_epi8('0');
+    const __m128i letter_offset = _mm_set1_epi8('a' - '0' - 10);
+
+    for (; idx + 16 <= size; idx += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)(data + idx));
+        __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), low_mask);
+        __m128i low = _mm_and_si128(bytes, low_mask);
+
+        high = _mm_add_epi8(_mm_add_epi8(high, zero_char), _mm_and_si128(_mm_cmpgt_epi8(high, nine), letter_offset));
+        low = _mm_add_epi8(_mm_add_epi8(low, zero_char), _mm_and_si128(_mm_cmpgt_epi8(low, nine), letter_offset));
+
+        _mm_storeu_si128((__m128i *)(out + 2 * idx), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128((__m128i *)(out + 2 * idx + 16), _mm_unpackhi_epi8(high, low));
+    }
+#endif
+
+    for (; idx < size; idx++) {
+        std::memcpy(out + 2 * idx, HEX_PAIRS + 2 * data[idx], 2);
+    }
+}
+
+std::string ctn::hexEncode(const std::string &data)
+{
+    std::string encoded(2 * data.size(), '\0');
+
+    if (!data.empty()) {
+        hexEncode((const unsigned char *)data.data(), data.size(), &encoded[0]);
+    }
+
+    return encoded;
+}